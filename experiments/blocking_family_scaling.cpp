@@ -0,0 +1,39 @@
+#include <iostream>
+#include "barrier_resilience/config.hpp"
+#include "barrier_resilience/statistics.hpp"
+#include "helpers.hpp"
+
+// Regression benchmark for the blocking family search.
+// Disks are placed with constant density, so the number of vertices visited by DFS grows linearly with number of
+// disks. Time spent per visited vertex should stay flat as n grows (if any step of the search copies per-phase state,
+// this number grows with n).
+int main() {
+    auto config = Config<int>::with_kdtree();
+
+    std::cout << "disks,phases,explored_vertices,time,ns_per_explored_vertex" << std::endl;
+
+    for (int n = 1000; n <= 1000000; n *= 10) {
+        for (int multiplier: {1, 2, 5}) {
+            const int number_of_disks = n * multiplier;
+            if (number_of_disks > 1000000) {
+                break;
+            }
+
+            auto params = ProblemParams{10, 0, 100, 0, number_of_disks / 20, number_of_disks};
+            auto disks = generate_disks(params);
+
+            Statistics statistics;
+            config.statistics = &statistics;
+
+            auto timer = Timer();
+            timer.start();
+            barrier_resilience_number_of_disks(disks, params.left, params.right, config);
+            double time = timer.time_elapsed();
+
+            std::cout << number_of_disks << "," << statistics.phases << "," << statistics.explored_vertices << ","
+                      << time << "," << time * 1e9 / std::max(1LL, statistics.explored_vertices) << std::endl;
+        }
+    }
+
+    return 0;
+}
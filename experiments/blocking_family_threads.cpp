@@ -0,0 +1,43 @@
+#include <iostream>
+#include <thread>
+#include "barrier_resilience/config.hpp"
+#include "barrier_resilience/statistics.hpp"
+#include "helpers.hpp"
+
+// Scaling of the solver with number of threads on the constant_density_time workload.
+// (same disk density as in constant_density_time, but larger instances, so that levels are wide enough for workers)
+// Every instance is solved with 1, 2, 4, ... threads; result must not depend on the number of threads.
+int main() {
+    const int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    std::cout << "disks,threads,paths,time,speedup" << std::endl;
+
+    for (int number_of_disks: {5000, 50000, 500000}) {
+        auto params = ProblemParams{10, 0, 100, 0, number_of_disks / 20, number_of_disks};
+        auto disks = generate_disks(params);
+
+        double single_thread_time = 0;
+        int single_thread_result = 0;
+
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            auto config = Config<int>::with_kdtree();
+            config.threads = threads;
+
+            auto timer = Timer();
+            timer.start();
+            int result = barrier_resilience_number_of_disks(disks, params.left, params.right, config);
+            double time = timer.time_elapsed();
+
+            if (threads == 1) {
+                single_thread_time = time;
+                single_thread_result = result;
+            }
+            check_eq(result, single_thread_result);
+
+            std::cout << number_of_disks << "," << threads << "," << result << "," << time << ","
+                      << single_thread_time / time << std::endl;
+        }
+    }
+
+    return 0;
+}
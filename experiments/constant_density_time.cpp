@@ -6,30 +6,35 @@
 int main() {
     const auto config_trivial = Config<int>::with_trivial_datastructure();
     const auto config_kdtree = Config<int>::with_kdtree();
+    const auto config_cgal_kdtree = Config<int>::with_cgal_kdtree();
+    const auto config_grid = Config<int>::with_grid();
 
     // Evaluate 5-times and take the average
     const auto repeats = 5;
 
     for (int i = 0; i < 5001; i += 100) {
 
-        double times_trivial = 0, times_kdtree = 0, times_ff = 0;
+        double times_trivial = 0, times_kdtree = 0, times_cgal_kdtree = 0, times_grid = 0, times_ff = 0;
 
         for (int j = 0; j < repeats; j++) {
 
             auto params = ProblemParams{10, 0, 100, 0, i / 20, i};
 
-            auto times = compare_algorithms(params, {config_trivial, config_kdtree},
+            auto times = compare_algorithms(params, {config_trivial, config_kdtree, config_cgal_kdtree, config_grid},
                                             {Algorithm::FordFulkerson}
             );
 
             times_trivial += times[0];
             times_kdtree += times[1];
-            times_ff += times[2];
+            times_cgal_kdtree += times[2];
+            times_grid += times[3];
+            times_ff += times[4];
         }
 
-        std::cout << i << "," << times_trivial / repeats << "," << times_kdtree / repeats << "," << times_ff / repeats
-                  << std::endl;
+        std::cout << i << "," << times_trivial / repeats << "," << times_kdtree / repeats << ","
+                  << times_cgal_kdtree / repeats << "," << times_grid / repeats << ","
+                  << times_ff / repeats << std::endl;
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -3,18 +3,43 @@
 #include <tuple>
 //#include "data_structure/trivial.hpp"
 #include "data_structure/kdtree.hpp"
+#include "data_structure/cgal_kdtree.hpp"
+#include "data_structure/grid.hpp"
 #include "helpers.hpp"
 
 const int N = 1000000;
 const int SIZE = 1000;
 
+// Build the data structure on given disks and perform 1000 random queries.
+// Returns construction time and time of all queries.
+std::pair<double, double> measure(DataStructure<int> &structure, const std::vector<GeometryObject<int>> &disks) {
+    auto timer = Timer();
+    timer.start();
+
+    // Generate data structure on current disks.
+    structure.rebuild(disks);
+
+    double construction_time = timer.time_elapsed();
+    timer.start();
+
+    // Perform 1000 random queries.
+    for (int i = 0; i < 1000; ++i) {
+        structure.intersecting(Disk<int>{{rand() % SIZE, rand() % SIZE}, 1});
+    }
+
+    return {construction_time, timer.time_elapsed()};
+}
+
 int main() {
 
-    // Compare speed of trivial data structure and kdtree.
+    // Compare speed of trivial data structure, kdtree (in-house and from CGAL) and grid.
     auto trivial = Trivial<int>();
     auto kdtree = KDTree<int>();
+    auto cgal_kdtree = CGALKDTree<int>();
+    auto grid = Grid<int>();
 
-    auto timer = Timer();
+    std::cout << "disks,trivial_construction,trivial_query,kdtree_construction,kdtree_query,"
+              << "cgal_kdtree_construction,cgal_kdtree_query,grid_construction,grid_query" << std::endl;
 
     // Generate 1000 disks.
     auto disks = std::vector<GeometryObject<int>>();
@@ -23,41 +48,19 @@ int main() {
 
         // Every 100000 disks, rebuild the data structure
         if (i % 10000 == 0) {
-            timer.start();
-
-            // Generate data structure on current disks.
-            trivial.rebuild(disks);
-
-            double trivial_construction_time = timer.time_elapsed();
-            timer.start();
-
-            // Perform 1000 random queries.
-            for (int i = 0; i < 1000; ++i) {
-                trivial.intersecting(Disk<int>{{rand() % SIZE, rand() % SIZE}, 1});
-            }
-
-            double trivial_query_time = timer.time_elapsed();
-            timer.start();
-
-            // Generate data structure on current disks.
-            kdtree.rebuild(disks);
-
-            double kdtree_construction_time = timer.time_elapsed();
-            timer.start();
-
-            // Perform 1000 random queries.
-            for (int i = 0; i < 1000; ++i) {
-                kdtree.intersecting(Disk<int>{{rand() % SIZE, rand() % SIZE}, 1});
-            }
-
-            double kdtree_query_time = timer.time_elapsed();
+            auto [trivial_construction_time, trivial_query_time] = measure(trivial, disks);
+            auto [kdtree_construction_time, kdtree_query_time] = measure(kdtree, disks);
+            auto [cgal_kdtree_construction_time, cgal_kdtree_query_time] = measure(cgal_kdtree, disks);
+            auto [grid_construction_time, grid_query_time] = measure(grid, disks);
 
             std::cout << i << "," << trivial_construction_time << "," << trivial_query_time << ","
-                      << kdtree_construction_time << "," << kdtree_query_time << std::endl;
+                      << kdtree_construction_time << "," << kdtree_query_time << ","
+                      << cgal_kdtree_construction_time << "," << cgal_kdtree_query_time << ","
+                      << grid_construction_time << "," << grid_query_time << std::endl;
         }
 
     }
 
 
     return 0;
-}
\ No newline at end of file
+}
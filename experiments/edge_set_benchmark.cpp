@@ -0,0 +1,142 @@
+#include <iostream>
+#include <unordered_map>
+#include "barrier_resilience/config.hpp"
+#include "barrier_resilience/blocking_family.hpp"
+#include "barrier_resilience/flow_state.hpp"
+#include "utils/flat_hash_set.hpp"
+#include "helpers.hpp"
+
+// Microbenchmark of edge sets on real phase traces.
+// Solver is run once and blocking families of all phases are recorded. Then the direct sum of the flow and each
+// family (what update_edges used to do every phase) is replayed with
+// - std::unordered_map with the old XOR hash (v -> u and u -> v collide),
+// - std::unordered_map with the fixed EdgeHash,
+// - FlatHashSet with packed edges.
+
+// Old hash functions, kept here only for comparison.
+class XorVertexHash {
+public:
+    size_t operator()(const TransformedVertex &vertex) const {
+        return std::hash<int>()(vertex.disk_index) ^ std::hash<bool>()(vertex.inbound);
+    }
+};
+
+class XorEdgeHash {
+public:
+    size_t operator()(const Edge &edge) const {
+        return XorVertexHash()(edge.from) ^ ~XorVertexHash()(edge.to);
+    }
+};
+
+// Blocking families of all phases.
+using Trace = std::vector<std::vector<Path>>;
+
+Trace record_trace(std::vector<Disk<int>> &disks, const ProblemParams &params, const Config<int> &config) {
+    add_index_to_disks(disks);
+    auto index = SpatialIndex<int>(disks, config);
+    auto flow = FlowState(disks.size());
+
+    Trace trace;
+    while (true) {
+        auto family = find_blocking_family<int>(flow, disks, params.left, params.right, index, config);
+        if (family.empty()) {
+            break;
+        }
+        for (const auto &path: family) {
+            flow.augment(path);
+        }
+        trace.push_back(std::move(family));
+    }
+    return trace;
+}
+
+// Replay the trace with std::unordered_map (same as the old update_edges). Returns number of edges in the end.
+template<class Hash>
+std::size_t replay_map(const Trace &trace) {
+    std::vector<Edge> edges;
+
+    for (const auto &family: trace) {
+        std::unordered_map<Edge, bool, Hash> edges_to_keep;
+        for (const auto &edge: edges) {
+            edges_to_keep[edge] = true;
+        }
+        for (const auto &path: family) {
+            for (const auto &edge: path) {
+                Edge reverse_edge = Edge(edge.to, edge.from);
+                if (edges_to_keep.contains(reverse_edge)) {
+                    edges_to_keep.erase(reverse_edge);
+                } else {
+                    edges_to_keep[edge] = true;
+                }
+            }
+        }
+
+        edges.clear();
+        for (const auto &p: edges_to_keep) {
+            edges.push_back(p.first);
+        }
+    }
+
+    return edges.size();
+}
+
+// Replay the trace with FlatHashSet of packed edges. Returns number of edges in the end.
+std::size_t replay_flat(const Trace &trace) {
+    std::vector<Edge> edges;
+
+    for (const auto &family: trace) {
+        auto edges_to_keep = FlatHashSet(edges.size());
+        for (const auto &edge: edges) {
+            edges_to_keep.insert(pack_edge(edge));
+        }
+        for (const auto &path: family) {
+            for (const auto &edge: path) {
+                if (!edges_to_keep.erase(pack_edge(Edge(edge.to, edge.from)))) {
+                    edges_to_keep.insert(pack_edge(edge));
+                }
+            }
+        }
+
+        edges.clear();
+        edges_to_keep.for_each([&edges](uint64_t key) { edges.push_back(unpack_edge(key)); });
+    }
+
+    return edges.size();
+}
+
+int main() {
+    const auto config = Config<int>::with_kdtree();
+    const int repeats = 5;
+
+    std::cout << "disks,phases,edges,xor_hash_map,fixed_hash_map,flat_set" << std::endl;
+
+    for (int number_of_disks: {1000, 10000, 100000}) {
+        auto params = ProblemParams{10, 0, 100, 0, number_of_disks / 20, number_of_disks};
+        auto disks = generate_disks(params);
+        auto trace = record_trace(disks, params, config);
+
+        double times[3] = {0, 0, 0};
+        std::size_t edges = 0;
+
+        for (int i = 0; i < repeats; i++) {
+            auto timer = Timer();
+
+            timer.start();
+            edges = replay_map<XorEdgeHash>(trace);
+            times[0] += timer.time_elapsed();
+
+            timer.start();
+            check_eq(static_cast<int>(replay_map<EdgeHash>(trace)), static_cast<int>(edges));
+            times[1] += timer.time_elapsed();
+
+            timer.start();
+            check_eq(static_cast<int>(replay_flat(trace)), static_cast<int>(edges));
+            times[2] += timer.time_elapsed();
+        }
+
+        std::cout << number_of_disks << "," << trace.size() << "," << edges << "," << times[0] / repeats << ","
+                  << times[1] / repeats << "," << times[2] / repeats << std::endl;
+    }
+
+    return 0;
+}
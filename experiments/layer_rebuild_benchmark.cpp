@@ -0,0 +1,66 @@
+#include <iostream>
+#include <memory>
+#include "barrier_resilience/config.hpp"
+#include "helpers.hpp"
+
+// Microbenchmark of the bottom-up BFS step (see expand_bottom_up in find_levels): a new structure is built from the
+// disks of the last layer and queried once with every unvisited disk, then destroyed.
+// Same disk density as in constant_density_time, frontier disks are a random part of the instance.
+double layer_time(const Config<int> &config, const std::vector<GeometryObject<int>> &frontier,
+                  const std::vector<Disk<int>> &queries, int &found) {
+    auto timer = Timer();
+    timer.start();
+
+    std::unique_ptr<DataStructure<int>> ds(config.data_structure_constructor());
+    ds->rebuild(frontier);
+    for (const auto &disk: queries) {
+        found += ds->intersecting(disk).has_value();
+    }
+
+    return timer.time_elapsed();
+}
+
+int main() {
+    const std::vector<std::pair<std::string, Config<int>>> configs = {
+            {"kdtree",      Config<int>::with_kdtree()},
+            {"cgal_kdtree", Config<int>::with_cgal_kdtree()},
+            {"grid",        Config<int>::with_grid()},
+            {"bvh",         Config<int>::with_bvh()},
+    };
+    const int repeats = 20;
+
+    std::cout << "frontier,queries";
+    for (const auto &[name, config]: configs) {
+        std::cout << "," << name;
+    }
+    std::cout << std::endl;
+
+    for (int frontier_size: {10, 100, 1000, 10000}) {
+        for (int queries_size: {frontier_size, 10 * frontier_size}) {
+            int number_of_disks = frontier_size + queries_size;
+            auto params = ProblemParams{10, 0, 100, 0, number_of_disks / 20, number_of_disks};
+            auto disks = generate_disks(params);
+
+            auto frontier = std::vector<GeometryObject<int>>(disks.begin(), disks.begin() + frontier_size);
+            auto queries = std::vector<Disk<int>>(disks.begin() + frontier_size, disks.end());
+
+            std::cout << frontier_size << "," << queries_size;
+            int expected_found = -1;
+            for (const auto &[name, config]: configs) {
+                double time = 0;
+                int found = 0;
+                for (int i = 0; i < repeats; i++) {
+                    time += layer_time(config, frontier, queries, found);
+                }
+                if (expected_found >= 0) {
+                    check_eq(found, expected_found);
+                }
+                expected_found = found;
+                std::cout << "," << time / repeats;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
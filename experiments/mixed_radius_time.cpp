@@ -0,0 +1,72 @@
+#include <iostream>
+#include <cmath>
+#include "barrier_resilience/config.hpp"
+#include "helpers.hpp"
+
+// Solver time on disks with mixed radii from 1 to 50:
+// - log-uniform radii, so every power-of-two class has about the same number of disks,
+// - few large disks, 2% of disks have radius 50 and the rest radius 1 (grid cells sized by the large disks hold many
+//   small disks).
+// Grid sizes its cells by the largest radius, hierarchical grid has one level per radius class.
+// Last columns are both grids on the same centers with equal radii, hierarchical grid should be close to the grid there.
+std::vector<Disk<int>> generate_mixed_disks(const ProblemParams &params, bool few_large) {
+    auto disks = generate_disks(params);
+    for (auto &disk: disks) {
+        if (few_large) {
+            disk.radius = rand() % 50 == 0 ? 50 : 1;
+        } else {
+            disk.radius = static_cast<int>(std::pow(50.0, rand() / static_cast<double>(RAND_MAX)));
+        }
+    }
+    return disks;
+}
+
+int main() {
+    const auto config_trivial = Config<int>::with_trivial_datastructure();
+    const auto config_grid = Config<int>::with_grid();
+    const auto config_hierarchical_grid = Config<int>::with_hierarchical_grid();
+
+    // Evaluate 5-times and take the average
+    const auto repeats = 5;
+
+    std::cout << "disks,trivial,grid,hierarchical_grid,few_large_grid,few_large_hierarchical_grid,"
+              << "equal_radii_grid,equal_radii_hierarchical_grid" << std::endl;
+
+    for (int i = 1000; i <= 20000; i += 1000) {
+        double times[7] = {0, 0, 0, 0, 0, 0, 0};
+
+        for (int j = 0; j < repeats; j++) {
+            auto params = ProblemParams{10, 0, 1000, 0, i / 2, i};
+
+            auto disks = generate_mixed_disks(params, false);
+            auto log_uniform = compare_algorithms(params, {config_trivial, config_grid, config_hierarchical_grid}, {},
+                                                  disks);
+
+            // Small disks are denser, so that they still form barriers
+            auto dense_params = ProblemParams{10, 0, 1000, 0, i / 20, i};
+            auto few_large = compare_algorithms(dense_params, {config_grid, config_hierarchical_grid}, {},
+                                                generate_mixed_disks(dense_params, true));
+
+            for (auto &disk: disks) {
+                disk.radius = params.radius;
+            }
+            auto equal = compare_algorithms(params, {config_grid, config_hierarchical_grid}, {}, disks);
+
+            for (int k = 0; k < 3; k++) {
+                times[k] += log_uniform[k];
+            }
+            for (int k = 0; k < 2; k++) {
+                times[3 + k] += few_large[k];
+                times[5 + k] += equal[k];
+            }
+        }
+
+        std::cout << i;
+        for (double time: times) {
+            std::cout << "," << time / repeats;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
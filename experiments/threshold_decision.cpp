@@ -0,0 +1,55 @@
+#include <iostream>
+#include "barrier_resilience/config.hpp"
+#include "helpers.hpp"
+
+// Time of the decision "is barrier resilience at least k?" compared to computing the barrier resilience.
+// Every instance (constant_density_time workload) is solved once, then barrier_resilience_at_least is timed for k
+// relative to the true value. The further k is from it, the sooner the search stops (k paths are found, or distances
+// in the residual graph show that fewer than k paths remain).
+int main() {
+    const auto config = Config<int>::with_kdtree();
+
+    // Evaluate 5-times and take the average
+    const auto repeats = 5;
+    const std::vector<double> k_ratios = {0.25, 0.5, 0.9, 1, 1.1, 2, 4};
+
+    std::cout << "disks,resilience,full_time";
+    for (auto ratio: k_ratios) {
+        std::cout << ",k=" << ratio << "x";
+    }
+    std::cout << std::endl;
+
+    for (int number_of_disks: {1000, 10000, 100000}) {
+        auto params = ProblemParams{10, 0, 100, 0, number_of_disks / 20, number_of_disks};
+        auto disks = generate_disks(params);
+
+        auto timer = Timer();
+        double full_time = 0;
+        int resilience = 0;
+        for (int j = 0; j < repeats; j++) {
+            timer.start();
+            resilience = barrier_resilience_number_of_disks(disks, params.left, params.right, config);
+            full_time += timer.time_elapsed();
+        }
+
+        std::cout << number_of_disks << "," << resilience << "," << full_time / repeats;
+
+        for (auto ratio: k_ratios) {
+            const int k = std::max(1, static_cast<int>(ratio * resilience));
+
+            double time = 0;
+            for (int j = 0; j < repeats; j++) {
+                timer.start();
+                bool at_least = barrier_resilience_at_least(disks, params.left, params.right, k, config);
+                time += timer.time_elapsed();
+                check_eq(at_least, resilience >= k);
+            }
+
+            // Speedup against full computation
+            std::cout << "," << full_time / time;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
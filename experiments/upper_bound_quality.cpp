@@ -0,0 +1,36 @@
+#include <iostream>
+#include "barrier_resilience/config.hpp"
+#include "helpers.hpp"
+
+// Quality and time of cheap upper bounds compared to the exact barrier resilience (constant_density_time workload).
+// - crossing curve: barrier_resilience_upper_bound (Dijkstra on a grid, no flow),
+// - BFS layer: smallest BFS layer of the intersection graph (bfs_layer_cut).
+int main() {
+    const auto config = Config<int>::with_kdtree();
+
+    std::cout << "disks,resilience,exact_time,curve_bound,curve_time,layer_bound,layer_time" << std::endl;
+
+    for (int number_of_disks: {1000, 10000, 100000}) {
+        auto params = ProblemParams{10, 0, 100, 0, number_of_disks / 20, number_of_disks};
+        auto disks = generate_disks(params);
+        auto timer = Timer();
+
+        timer.start();
+        int resilience = barrier_resilience_number_of_disks(disks, params.left, params.right, config);
+        double exact_time = timer.time_elapsed();
+
+        timer.start();
+        int curve_bound = barrier_resilience_upper_bound(disks, params.left, params.right);
+        double curve_time = timer.time_elapsed();
+
+        timer.start();
+        auto index = SpatialIndex<int>(disks, config);
+        int layer_bound = static_cast<int>(bfs_layer_cut(disks, params.left, params.right, index).size());
+        double layer_time = timer.time_elapsed();
+
+        std::cout << number_of_disks << "," << resilience << "," << exact_time << "," << curve_bound << ","
+                  << curve_time << "," << layer_bound << "," << layer_time << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "augmenting_path.hpp"
+
+template<class T>
+std::optional<Path> find_augmenting_path(
+        const FlowState &flow,
+        const std::vector<Disk<T>> &disks,
+        const T &left_border_x,
+        const T &right_border_x,
+        SpatialIndex<T> &index,
+        VertexLevels *final_levels
+) {
+    const auto left_border = Border<T>{left_border_x, true};
+    const auto right_border = Border<T>{right_border_x, false};
+
+    const auto &prev = flow.prev;
+    const auto &next = flow.next;
+
+    if (disks.empty() || intersects(left_border, right_border)) {
+        // Path without disks does not count (same as in find_blocking_family)
+        return {};
+    }
+
+    // Reached vertices, levels are depths in the DFS tree
+    auto reached = VertexLevels(disks.size());
+    reached.set(source, 0);
+
+    // Disks whose inbound vertex was not reached yet.
+    // Every outbound vertex has a single incoming edge in the residual graph (from its inbound vertex, or from the
+    // next vertex on its path), so outbound vertices do not need to be tracked.
+    auto &ds = *index.structure;
+    auto unvisited = index.all_disks();
+
+    // Neighbors of source, inbound vertices of disks intersecting the left border (except those already used by a path
+    // from source). They are claimed at once, so the left border query is done only once.
+    std::vector<TransformedVertex> first_vertices;
+    std::vector<int> used_first_disks;
+    while (true) {
+        auto n = ds.intersecting(left_border, unvisited);
+        if (!n.has_value()) {
+            break;
+        }
+        unvisited.erase(n.value().get_index());
+
+        auto v = disk_to_transformed_vertex(n.value(), true);
+        if (prev.points_to(v, source)) {
+            used_first_disks.push_back(v.disk_index);
+        } else {
+            first_vertices.push_back(v);
+        }
+    }
+    // Disks used by a path from source can still be reached from other disks
+    for (auto d: used_first_disks) {
+        unvisited.insert(d);
+    }
+
+    // Current path of the DFS (without source)
+    std::vector<TransformedVertex> stack;
+
+    auto push = [&](const TransformedVertex &v) {
+        reached.set(v, static_cast<int32_t>(stack.size()) + 1);
+        stack.push_back(v);
+    };
+
+    // Next neighbor of vertex v in the residual graph which was not reached yet
+    auto next_neighbor = [&](const TransformedVertex &v) -> std::optional<TransformedVertex> {
+        if (v.inbound) {
+            // - if inbound vertex lies on some path, residual graph contains only reverse edge v_inbound -> prev
+            // - otherwise there is edge v_inbound -> v_outbound
+            auto u = prev.contains(v) ? prev[v] : TransformedVertex{v.disk_index, false};
+            if (reached.contains(u)) {
+                return {};
+            }
+            return u;
+        }
+
+        // Edges v_outbound -> u_inbound for intersecting disks u (including reverse edge v_outbound -> v_inbound,
+        // disk intersects itself). Edge to next[v_outbound] is never returned, its inbound vertex was already reached.
+        auto n = ds.intersecting(disks[v.disk_index], unvisited);
+        if (!n.has_value()) {
+            return {};
+        }
+        unvisited.erase(n.value().get_index());
+
+        auto u = disk_to_transformed_vertex(n.value(), true);
+        assert(!next.points_to(v, u));
+        return u;
+    };
+
+    for (const auto &first: first_vertices) {
+        push(first);
+
+        while (!stack.empty()) {
+            const auto v = stack.back();
+
+            if (!v.inbound && intersects(disks[v.disk_index], right_border)) {
+                // Found sink, convert the DFS path to list of edges
+                Path path;
+                path.emplace_back(source, stack.front());
+                for (std::size_t i = 0; i + 1 < stack.size(); i++) {
+                    path.emplace_back(stack[i], stack[i + 1]);
+                }
+                path.emplace_back(stack.back(), sink);
+                return path;
+            }
+
+            auto u = next_neighbor(v);
+            if (u.has_value()) {
+                push(u.value());
+            } else {
+                // Dead end, stays reached
+                stack.pop_back();
+            }
+        }
+    }
+
+    if (final_levels != nullptr) {
+        *final_levels = std::move(reached);
+    }
+    return {};
+}
+
+// Force compiler to instantiate the template for the types we need
+template std::optional<Path> find_augmenting_path<int>(const FlowState &flow, const std::vector<Disk<int>> &disks,
+        const int &left_border_x, const int &right_border_x, SpatialIndex<int> &index, VertexLevels *final_levels);
+
+template std::optional<Path> find_augmenting_path<double>(const FlowState &flow,
+        const std::vector<Disk<double>> &disks, const double &left_border_x, const double &right_border_x,
+        SpatialIndex<double> &index, VertexLevels *final_levels);
@@ -0,0 +1,33 @@
+#ifndef BARRIER_RESILIENCE_AUGMENTING_PATH_HPP
+#define BARRIER_RESILIENCE_AUGMENTING_PATH_HPP
+
+#include <vector>
+#include <optional>
+#include "utils/geometry_objects.hpp"
+#include "utils/transformed_graph.hpp"
+#include "utils/vertex_state.hpp"
+#include "spatial_index.hpp"
+#include "flow_state.hpp"
+#include "config.hpp"
+
+// Find a single path from source to sink in the residual graph R(G', flow) by DFS (not necessarily the shortest one).
+// Unlike a phase (find_levels + find_blocking_family), there is no BFS over the whole residual graph and no level
+// views, search stops as soon as it reaches sink. Cheaper than a phase when the phase would find only a few paths.
+// Returns nothing if the flow is maximum.
+template<class T>
+std::optional<Path> find_augmenting_path(
+        // Set of vertex disjoint paths in G' (current flow)
+        const FlowState &flow,
+        // Disks representing the vertices of G
+        const std::vector<Disk<T>> &disks,
+        // Left and right boundary of the available space
+        const T &left_border_x,
+        const T &right_border_x,
+        // Spatial index built from disks, reused by all searches
+        SpatialIndex<T> &index,
+        // If set and no path is found, vertices reachable from source in the residual graph are stored here.
+        // (their levels are depths in the DFS tree, not distances)
+        VertexLevels *final_levels = nullptr
+);
+
+#endif //BARRIER_RESILIENCE_AUGMENTING_PATH_HPP
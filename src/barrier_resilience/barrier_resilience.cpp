@@ -1,104 +1,171 @@
 #include "barrier_resilience.hpp"
 
-std::vector<Edge> update_edges(std::vector<Edge> &edges, const std::vector<Path> &paths) {
-    // Add edges from paths to vector of edges.
-    // Duplicate edges should not appear in the result if the steps before were correct.
-    // What can happen is that an edge appears as v -> u and we also have found a path including u -> v. In this case, we
-    // should discard both edges.
-
-    std::unordered_map<Edge, bool, EdgeHash> edges_to_keep;
-
-    for (const auto &edge: edges) {
-        edges_to_keep[edge] = true;
-    }
-    for (const auto &path: paths) {
-        for (const auto &edge: path) {
-            // Check if reverse edge is already in a map.
-            // If it is, remove it and don't add the current edge.
-            Edge reverse_edge = Edge(edge.to, edge.from);
-            if (edges_to_keep.contains(reverse_edge)) {
-                edges_to_keep.erase(reverse_edge);
-            } else {
-                edges_to_keep[edge] = true;
-            }
-        }
-    }
+// Solver steps are local to this file, only the functions declared in the header are exported.
+namespace {
 
-    std::vector<Edge> result = {};
-    for (const auto &p: edges_to_keep) {
-        if (p.second == true) {
-            result.push_back(p.first);
-        }
-    }
+// Called before every phase with the number of paths found so far and an upper bound on the number of paths which can
+// still be found, search stops when it returns true.
+using StopCondition = std::function<bool(int path_count, long long remaining_bound)>;
 
-    return result;
-}
+// Phases which find at most this many paths switch to single path searches (until their cost is measured).
+const double initial_single_path_threshold = 2;
 
 struct BlockingPathsResult {
     int path_count;
-    std::vector<Edge> edges;
+    // Maximum flow, paths found in all phases.
+    FlowState flow;
+    // Levels of vertices reachable from source in the residual graph of the maximum flow, computed by BFS of the last
+    // phase (the one which did not reach sink), or by the last single path search.
+    VertexLevels final_levels;
+    // False if the search was stopped before the flow was maximum (final_levels are not valid then).
+    bool maximum;
 };
 
 // Find blocking family of paths.
 // (returned as a collection of edges)
+// If stop condition is set, search stops as soon as it returns true (flow is not necessarily maximum then).
 template<class T>
-BlockingPathsResult get_blocking_paths(std::vector<Disk<T>> disks,
+BlockingPathsResult get_blocking_paths(const std::vector<Disk<T>> &disks,
                                        const T &left_border_x, const T &right_border_x,
-                                       const Config<T> &config) {
-    // We won't have a family of paths, but just a collection of all edges.
-    // (that way, we can compute direct sum of all edges)
-    std::vector<Edge> edges = {};
+                                       SpatialIndex<T> &index,
+                                       const Config<T> &config,
+                                       const StopCondition &stop = {}) {
+    // We won't have a family of paths, but just previous and next vertex on a path for each vertex.
+    // (that way, we can compute direct sum of the flow and new paths in place)
+    auto flow = FlowState(disks.size());
 
     // Number of disjoint paths = number of disks.
     // (measuring max s-t flow in a graph)
     int path_count = 0;
 
-    while (true) {
+    using Clock = std::chrono::steady_clock;
+    if (config.warm_start) {
+        auto warm_start_begin = Clock::now();
+        // Start from a greedy packing of disjoint paths instead of the empty flow
+        // (any flow can be augmented to the maximum one, phases only find the paths greedy packing missed)
+        auto packing = greedy_path_packing(disks, left_border_x, right_border_x, index);
+        for (const auto &path: packing) {
+            flow.augment(path);
+        }
+        path_count += packing.size();
+
+        if (config.statistics != nullptr) {
+            config.statistics->paths += packing.size();
+            config.statistics->warm_start_paths += packing.size();
+            config.statistics->warm_start_time +=
+                    std::chrono::duration<double>(Clock::now() - warm_start_begin).count();
+        }
+    }
+
+    // Nothing is reachable if there are no disks (the last phase does not run BFS then).
+    auto final_levels = VertexLevels(disks.size());
+
+    // Upper bound on the number of paths which can still be found (only maintained if there is a stop condition).
+    // Every path starts in a disk intersecting the left border and ends in a disk intersecting the right border.
+    long long remaining_bound = 0;
+    if (stop) {
+        long long left_disks = 0;
+        long long right_disks = 0;
+        for (const auto &disk: disks) {
+            left_disks += intersects(disk, Border<T>{left_border_x, true});
+            right_disks += intersects(disk, Border<T>{right_border_x, false});
+        }
+        remaining_bound = std::min(left_disks, right_disks) - path_count;
+    }
+    bool maximum = false;
+
+    // Hybrid strategy (Config::hybrid_phases): once phases find only a few paths, paths are found one by one by
+    // find_augmenting_path. Single path search is worth it while it is faster than a phase per path, so the threshold
+    // is the number of paths a phase has to find to beat it (time of the last phase / average time of single search).
+    // Until single search is measured, initial threshold is used.
+    bool single_path_mode = false;
+    double single_path_threshold = initial_single_path_threshold;
+    double last_phase_time = 0;
+    double single_path_time = -1;
+
+    while (!stop || !stop(path_count, remaining_bound)) {
+        auto start = Clock::now();
+
+        if (single_path_mode) {
+            auto path = find_augmenting_path(flow, disks, left_border_x, right_border_x, index, &final_levels);
+
+            if (!path.has_value()) {
+                // No more paths to find.
+                maximum = true;
+                break;
+            }
+
+            path_count++;
+            remaining_bound--;
+            flow.augment(path.value());
+
+            if (config.statistics != nullptr) {
+                config.statistics->single_path_searches++;
+                config.statistics->paths++;
+            }
+
+            // Exponential moving average, cost of searches changes as the flow grows
+            const double time = std::chrono::duration<double>(Clock::now() - start).count();
+            single_path_time = single_path_time < 0 ? time : (single_path_time + time) / 2;
+            single_path_threshold = last_phase_time / std::max(single_path_time, 1e-9);
+
+            if (single_path_threshold < 1) {
+                // Phase would find at least one path faster, go back to phases
+                single_path_mode = false;
+            }
+            continue;
+        }
+
         // Find blocking family of paths.
-        auto blocking_family = find_blocking_family<T>(edges, disks, left_border_x, right_border_x, config);
+        auto blocking_family = find_blocking_family<T>(flow, disks, left_border_x, right_border_x, index, config,
+                                                       &final_levels);
 
         if (blocking_family.empty()) {
             // No more paths to find.
+            maximum = true;
             break;
         }
 
         path_count += blocking_family.size();
 
-        // Perform direct sum of all edges in the family.
-        edges = update_edges(edges, blocking_family);
-    }
-
-    return BlockingPathsResult{path_count, edges};
-}
+        if (config.statistics != nullptr) {
+            config.statistics->phases++;
+            config.statistics->paths += blocking_family.size();
+        }
 
-template<class T>
-int barrier_resilience_number_of_disks(std::vector<Disk<T>> &disks,
-                                       const T &left_border_x,
-                                       const T &right_border_x,
-                                       const Config<T> &config) {
-    // Set index to each disk (so we can track them in the data structure)
-    add_index_to_disks(disks);
+        // Perform direct sum of the flow and all paths in the family.
+        for (const auto &path: blocking_family) {
+            flow.augment(path);
+        }
 
-    auto r = get_blocking_paths(disks, left_border_x, right_border_x, config);
-    return r.path_count;
-}
+        // Paths of the family are shortest, so their length is the distance d of sink from source in the residual
+        // graph, and the distance after the phase is at least d + 2. Remaining flow consists of paths which do not
+        // share inbound vertices and each of them has at least (d + 1) / 2 of them, so there are at most 2n / (d + 1).
+        const auto distance = static_cast<long long>(blocking_family.front().size());
+        remaining_bound = std::min(remaining_bound - static_cast<long long>(blocking_family.size()),
+                                   2 * static_cast<long long>(disks.size()) / (distance + 1));
 
-template<class T>
-std::vector<int> barrier_resilience_disks(std::vector<Disk<T>> &disks,
-                                          const T &left_border_x,
-                                          const T &right_border_x,
-                                          const Config<T> &config) {
-    // Set index to each disk (so we can track them in the data structure)
-    add_index_to_disks(disks);
+        last_phase_time = std::chrono::duration<double>(Clock::now() - start).count();
+        if (single_path_time >= 0) {
+            single_path_threshold = last_phase_time / std::max(single_path_time, 1e-9);
+        }
+        single_path_mode = config.hybrid_phases &&
+                           static_cast<double>(blocking_family.size()) <= single_path_threshold;
+    }
 
-    auto r = get_blocking_paths(disks, left_border_x, right_border_x, config);
+    if (config.hybrid_phases && config.statistics != nullptr) {
+        config.statistics->single_path_threshold = single_path_threshold;
+    }
 
-    // Find disks which represent min cut
+    return BlockingPathsResult{path_count, std::move(flow), std::move(final_levels), maximum};
+}
 
-    // Re-run find levels
-    auto find_levels_result = find_levels(r.edges, disks, left_border_x, right_border_x, config);
-    auto levels = find_levels_result.levels;
-    auto prev = find_levels_result.prev;
+// Find disks which represent min cut, given maximum flow.
+template<class T>
+std::vector<int> min_cut_disks(const std::vector<Disk<T>> &disks, const BlockingPathsResult &r) {
+    // Vertices reachable in the residual graph, found by the last phase
+    const auto &levels = r.final_levels;
+    const auto &prev = r.flow.prev;
 
     std::vector<int> blocking_disks;
 
@@ -132,6 +199,301 @@ std::vector<int> barrier_resilience_disks(std::vector<Disk<T>> &disks,
     return blocking_disks;
 }
 
+// Solution of a (sub)problem.
+struct Solution {
+    // Minimum number of disks that need to be removed (lower bound if solution is not exact).
+    int number_of_disks;
+    // Indices of disks that need to be removed (only if requested and solution is exact).
+    std::vector<int> disks;
+    // False if the search was stopped by a stop condition.
+    bool exact = true;
+};
+
+// Solve the problem for disks with indices set, blocking disks are found only if find_disks is set.
+// If stop condition is set, search can stop early (see get_blocking_paths), blocking disks are not found then.
+// Pool (see make_thread_pool) is shared by all subproblems of a solve.
+template<class T>
+Solution solve(const std::vector<Disk<T>> &disks,
+               const T &left_border_x, const T &right_border_x,
+               const Config<T> &config,
+               bool find_disks,
+               const StopCondition &stop,
+               ThreadPool *pool) {
+    // Spatial index is built once and shared by all phases
+    auto index = SpatialIndex<T>(disks, config, pool);
+
+    auto r = get_blocking_paths(disks, left_border_x, right_border_x, index, config, stop);
+
+    if (!find_disks || !r.maximum) {
+        return {r.path_count, {}, r.maximum};
+    }
+    return {r.path_count, min_cut_disks(disks, r)};
+}
+
+// Solve the problem restricted to given subset of disks (indices in increasing order) with given solver.
+// Disks of the subset get new indices (positions in the subset), returned disks are mapped back to the input.
+template<class T, class Solver>
+Solution solve_subset(const std::vector<Disk<T>> &disks,
+                      const std::vector<int> &subset,
+                      const T &left_border_x, const T &right_border_x,
+                      const Config<T> &config,
+                      bool find_disks,
+                      const StopCondition &stop,
+                      ThreadPool *pool,
+                      Solver solver) {
+    std::vector<Disk<T>> subset_disks;
+    subset_disks.reserve(subset.size());
+    for (auto d: subset) {
+        subset_disks.push_back(disks[d]);
+    }
+    add_index_to_disks(subset_disks);
+
+    auto solution = solver(subset_disks, left_border_x, right_border_x, config, find_disks, stop, pool);
+    for (auto &d: solution.disks) {
+        d = subset[d];
+    }
+    return solution;
+}
+
+// Solve every connected component of the intersection graph which touches both borders separately and sum the
+// solutions. Components are independent problems, so they are solved in parallel if there is a thread pool.
+// Stop condition sees the whole problem: paths found in all components and the sum of their bounds (components which
+// did not start yet count with the number of their disks touching a border), so every component stops once it
+// returns true.
+template<class T>
+Solution solve_by_components(const std::vector<Disk<T>> &disks,
+                             const T &left_border_x, const T &right_border_x,
+                             const Config<T> &config,
+                             bool find_disks,
+                             const StopCondition &stop,
+                             ThreadPool *pool) {
+    if (intersects(Border<T>{left_border_x, true}, Border<T>{right_border_x, false})) {
+        // Borders touch, components do not matter
+        return solve(disks, left_border_x, right_border_x, config, find_disks, stop, pool);
+    }
+
+    auto index = SpatialIndex<T>(disks, config, pool);
+    const auto components = border_to_border_components(disks, left_border_x, right_border_x, index);
+
+    std::vector<Solution> solutions(components.size());
+    std::vector<Statistics> statistics(components.size());
+
+    // Paths found and bounds on remaining paths of all components, for the stop condition.
+    std::vector<int> component_paths(components.size(), 0);
+    std::vector<long long> component_bounds(components.size(), 0);
+    int total_paths = 0;
+    long long total_bound = 0;
+    std::mutex stop_mutex;
+    if (stop) {
+        for (std::size_t c = 0; c < components.size(); c++) {
+            long long left_disks = 0;
+            long long right_disks = 0;
+            for (auto d: components[c]) {
+                left_disks += intersects(disks[d], Border<T>{left_border_x, true});
+                right_disks += intersects(disks[d], Border<T>{right_border_x, false});
+            }
+            component_bounds[c] = std::min(left_disks, right_disks);
+            total_bound += component_bounds[c];
+        }
+    }
+
+    // Update counts of the component, under lock (components may run in parallel, stop is called once per phase).
+    auto update = [&](std::size_t c, int path_count, long long remaining_bound) {
+        total_paths += path_count - component_paths[c];
+        total_bound += remaining_bound - component_bounds[c];
+        component_paths[c] = path_count;
+        component_bounds[c] = remaining_bound;
+    };
+
+    auto solve_component = [&](std::size_t c, const Config<T> &component_config, ThreadPool *component_pool) {
+        StopCondition component_stop;
+        if (stop) {
+            component_stop = [&, c](int path_count, long long remaining_bound) {
+                std::lock_guard lock(stop_mutex);
+                update(c, path_count, remaining_bound);
+                return stop(total_paths, total_bound);
+            };
+        }
+
+        solutions[c] = solve_subset(disks, components[c], left_border_x, right_border_x, component_config, find_disks,
+                                    component_stop, component_pool, solve<T>);
+
+        if (stop && solutions[c].exact) {
+            // Component is solved, nothing remains in it.
+            std::lock_guard lock(stop_mutex);
+            update(c, solutions[c].number_of_disks, 0);
+        }
+    };
+
+    if (index.pool != nullptr && components.size() > 1) {
+        // Components are solved in parallel (largest first), each of them on a single thread.
+        index.pool->parallel_for(components.size(), [&](std::size_t c) {
+            auto component_config = config;
+            component_config.threads = 1;
+            component_config.statistics = config.statistics != nullptr ? &statistics[c] : nullptr;
+            solve_component(c, component_config, nullptr);
+        });
+
+        if (config.statistics != nullptr) {
+            for (const auto &s: statistics) {
+                config.statistics->add(s);
+            }
+        }
+    } else {
+        // Components are solved one by one, phases of each of them use the whole pool.
+        for (std::size_t c = 0; c < components.size(); c++) {
+            solve_component(c, config, pool);
+        }
+    }
+
+    Solution solution = {0, {}};
+    for (const auto &s: solutions) {
+        solution.number_of_disks += s.number_of_disks;
+        solution.disks.insert(solution.disks.end(), s.disks.begin(), s.disks.end());
+        solution.exact = solution.exact && s.exact;
+    }
+    std::sort(solution.disks.begin(), solution.disks.end());
+
+    return solution;
+}
+
+// Solve the problem with all preprocessing steps enabled in config.
+template<class T>
+Solution solve_problem(const std::vector<Disk<T>> &disks,
+                       const T &left_border_x, const T &right_border_x,
+                       const Config<T> &config,
+                       bool find_disks,
+                       ThreadPool *pool,
+                       const StopCondition &stop = {}) {
+    auto solver = config.split_components ? solve_by_components<T> : solve<T>;
+
+    if (!config.prune_dead_ends ||
+        intersects(Border<T>{left_border_x, true}, Border<T>{right_border_x, false})) {
+        return solver(disks, left_border_x, right_border_x, config, find_disks, stop, pool);
+    }
+
+    // Remove disks which are not on any chain from left to right border
+    std::vector<int> chain_disks;
+    {
+        auto index = SpatialIndex<T>(disks, config, pool);
+        chain_disks = border_to_border_chain_disks(disks, left_border_x, right_border_x, index);
+    }
+
+    if (config.statistics != nullptr) {
+        config.statistics->input_disks += disks.size();
+        config.statistics->pruned_disks += disks.size() - chain_disks.size();
+    }
+
+    return solve_subset(disks, chain_disks, left_border_x, right_border_x, config, find_disks, stop, pool, solver);
+}
+
+} // namespace
+
+template<class T>
+int barrier_resilience_number_of_disks(std::vector<Disk<T>> &disks,
+                                       const T &left_border_x,
+                                       const T &right_border_x,
+                                       const Config<T> &config) {
+    // Set index to each disk (so we can track them in the data structure)
+    add_index_to_disks(disks);
+
+    auto pool = make_thread_pool(config);
+    return solve_problem(disks, left_border_x, right_border_x, config, false, pool.get()).number_of_disks;
+}
+
+template<class T>
+std::vector<int> barrier_resilience_disks(std::vector<Disk<T>> &disks,
+                                          const T &left_border_x,
+                                          const T &right_border_x,
+                                          const Config<T> &config) {
+    // Set index to each disk (so we can track them in the data structure)
+    add_index_to_disks(disks);
+
+    auto pool = make_thread_pool(config);
+    return solve_problem(disks, left_border_x, right_border_x, config, true, pool.get()).disks;
+}
+
+
+template<class T>
+bool barrier_resilience_at_least(std::vector<Disk<T>> &disks,
+                                 const T &left_border_x,
+                                 const T &right_border_x,
+                                 int k,
+                                 const Config<T> &config) {
+    if (k <= 0) {
+        return true;
+    }
+
+    // Set index to each disk (so we can track them in the data structure)
+    add_index_to_disks(disks);
+
+    // Stop when k paths are found, or when fewer than k paths can remain
+    auto stop = [k](int path_count, long long remaining_bound) {
+        return path_count >= k || path_count + remaining_bound < k;
+    };
+    auto pool = make_thread_pool(config);
+    return solve_problem(disks, left_border_x, right_border_x, config, false, pool.get(), stop).number_of_disks >= k;
+}
+
+template<class T>
+int barrier_resilience_upper_bound(const std::vector<Disk<T>> &disks,
+                                   const T &left_border_x,
+                                   const T &right_border_x) {
+    return static_cast<int>(crossing_curve_cut(disks, left_border_x, right_border_x).size());
+}
+
+template<class T>
+AnytimeResult barrier_resilience_anytime(std::vector<Disk<T>> &disks,
+                                         const T &left_border_x,
+                                         const T &right_border_x,
+                                         std::chrono::steady_clock::time_point deadline,
+                                         const std::function<void(int lower_bound, int upper_bound)> &callback,
+                                         const Config<T> &config) {
+    // Set index to each disk (so we can track them in the data structure)
+    add_index_to_disks(disks);
+
+    // Smaller of two cheap cuts
+    std::vector<int> cut = crossing_curve_cut(disks, left_border_x, right_border_x);
+    auto pool = make_thread_pool(config);
+    {
+        auto index = SpatialIndex<T>(disks, config, pool.get());
+        auto layer_cut = bfs_layer_cut(disks, left_border_x, right_border_x, index);
+        if (layer_cut.size() < cut.size()) {
+            cut = std::move(layer_cut);
+        }
+    }
+
+    int lower_bound = 0;
+    int upper_bound = static_cast<int>(cut.size());
+
+    // Search stops when the deadline passes or when enough paths are found to prove the cut minimal.
+    // (bound on remaining paths only lowers the upper bound, flow has to be maximum to find its cut)
+    auto stop = [&](int path_count, long long remaining_bound) {
+        lower_bound = path_count;
+        upper_bound = static_cast<int>(std::min<long long>(upper_bound, path_count + remaining_bound));
+        if (callback) {
+            callback(lower_bound, upper_bound);
+        }
+        return lower_bound >= static_cast<int>(cut.size()) || std::chrono::steady_clock::now() >= deadline;
+    };
+
+    auto solution = solve_problem(disks, left_border_x, right_border_x, config, true, pool.get(), stop);
+
+    AnytimeResult result;
+    if (solution.exact) {
+        result = {solution.number_of_disks, solution.number_of_disks, std::move(solution.disks)};
+    } else if (lower_bound >= static_cast<int>(cut.size())) {
+        std::sort(cut.begin(), cut.end());
+        result = {lower_bound, lower_bound, std::move(cut)};
+    } else {
+        result = {lower_bound, upper_bound, {}};
+    }
+
+    if (callback) {
+        callback(result.lower_bound, result.upper_bound);
+    }
+    return result;
+}
 
 // Force compiler to instantiate template for int and double
 template int barrier_resilience_number_of_disks<int>(std::vector<Disk<int>> &disks,
@@ -152,4 +514,38 @@ template std::vector<int> barrier_resilience_disks<int>(std::vector<Disk<int>> &
 template std::vector<int> barrier_resilience_disks<double>(std::vector<Disk<double>> &disks,
                                                            const double &left_border_x,
                                                            const double &right_border_x,
-                                                           const Config<double> &config);
\ No newline at end of file
+                                                           const Config<double> &config);
+
+template bool barrier_resilience_at_least<int>(std::vector<Disk<int>> &disks,
+                                               const int &left_border_x,
+                                               const int &right_border_x,
+                                               int k,
+                                               const Config<int> &config);
+
+template bool barrier_resilience_at_least<double>(std::vector<Disk<double>> &disks,
+                                                  const double &left_border_x,
+                                                  const double &right_border_x,
+                                                  int k,
+                                                  const Config<double> &config);
+
+template int barrier_resilience_upper_bound<int>(const std::vector<Disk<int>> &disks,
+                                                 const int &left_border_x,
+                                                 const int &right_border_x);
+
+template int barrier_resilience_upper_bound<double>(const std::vector<Disk<double>> &disks,
+                                                    const double &left_border_x,
+                                                    const double &right_border_x);
+
+template AnytimeResult barrier_resilience_anytime<int>(std::vector<Disk<int>> &disks,
+                                                       const int &left_border_x,
+                                                       const int &right_border_x,
+                                                       std::chrono::steady_clock::time_point deadline,
+                                                       const std::function<void(int, int)> &callback,
+                                                       const Config<int> &config);
+
+template AnytimeResult barrier_resilience_anytime<double>(std::vector<Disk<double>> &disks,
+                                                          const double &left_border_x,
+                                                          const double &right_border_x,
+                                                          std::chrono::steady_clock::time_point deadline,
+                                                          const std::function<void(int, int)> &callback,
+                                                          const Config<double> &config);
@@ -4,8 +4,16 @@
 #include <vector>
 #include <unordered_map>
 #include <cassert>
+#include <chrono>
+#include <optional>
+#include <functional>
+#include <mutex>
 #include "utils/geometry_objects.hpp"
 #include "blocking_family.hpp"
+#include "components.hpp"
+#include "warm_start.hpp"
+#include "augmenting_path.hpp"
+#include "upper_bound.hpp"
 #include "config.hpp"
 
 // Returns a minimum number of disks that need to be removed to be able to
@@ -26,4 +34,44 @@ std::vector<int> barrier_resilience_disks(std::vector<Disk<T>> &disks,
                                           const T &right_border_x,
                                           const Config<T> &config);
 
+// Returns true if at least k disks need to be removed to be able to move from top to bottom.
+// Stops as soon as the answer is known: when k disjoint paths are found, or when the distances in the residual graph
+// show that fewer than k paths can remain. Much faster than computing the number of disks when k is far from it.
+template<class T>
+bool barrier_resilience_at_least(std::vector<Disk<T>> &disks,
+                                 const T &left_border_x,
+                                 const T &right_border_x,
+                                 int k,
+                                 const Config<T> &config);
+
+// Returns an upper bound on the minimum number of disks that need to be removed, computed without the flow: number of
+// disks crossed by a curve from top to bottom found by crossing_curve_cut. Runs in about O(n log n).
+template<class T>
+int barrier_resilience_upper_bound(const std::vector<Disk<T>> &disks,
+                                   const T &left_border_x,
+                                   const T &right_border_x);
+
+// Bounds on the barrier resilience found by barrier_resilience_anytime.
+struct AnytimeResult {
+    // Number of disjoint paths found so far, at least this many disks need to be removed.
+    int lower_bound;
+    // Size of the smallest cut found so far, at most this many disks need to be removed.
+    int upper_bound;
+    // Disks which need to be removed (same as barrier_resilience_disks), only if lower_bound == upper_bound.
+    std::vector<int> disks_if_exact;
+};
+
+// Anytime version of barrier_resilience_disks: search stops at the deadline (or when the bounds meet) and returns the
+// best bounds found until then. Lower bound grows with every phase, upper bound is the smaller of the cuts found by
+// bfs_layer_cut and crossing_curve_cut, lowered by counting paths which can still remain.
+// Callback (if set) gets the current bounds before every phase and the final ones at the end.
+// (deadline is checked before every phase, with Config::split_components in every component)
+template<class T>
+AnytimeResult barrier_resilience_anytime(std::vector<Disk<T>> &disks,
+                                         const T &left_border_x,
+                                         const T &right_border_x,
+                                         std::chrono::steady_clock::time_point deadline,
+                                         const std::function<void(int lower_bound, int upper_bound)> &callback,
+                                         const Config<T> &config);
+
 #endif //BARRIER_RESILIENCE_BARRIER_RESILIENCE_HPP
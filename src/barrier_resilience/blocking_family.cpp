@@ -1,160 +1,302 @@
 #include "blocking_family.hpp"
 
 
+// Phase state and DFS steps are local to this file (even_tarjan.cpp has its own DfsFrame).
+namespace {
+
+// Frame of the iterative DFS.
+struct DfsFrame {
+    TransformedVertex v;
+    int level;
+    // Was the first (non data structure) edge of this vertex already tried?
+    bool started;
+};
+
+// Number of vertices of a level stamped into its view by a single task.
+const std::size_t parallel_build_chunk_size = 4096;
+
+// Workers are used only if level 1 has at least this many vertices (each worker needs its own first vertex).
+const std::size_t parallel_first_level_size = 64;
+
+// State of a single worker in a phase, shared by all steps of its DFS.
+// Levels and paths from the previous phases are only read; explored vertices and views are updated in place.
+// If multiple workers search at the same time, explored vertices and deletions from views are shared between them
+// (vertices are claimed atomically), everything else is private to the worker.
 template<class T>
-std::optional<std::vector<TransformedVertex>> dfs_explore(
-        // Used to query intersecting disks.
-        std::vector<DataStructure<T> *> &ds,
-        const std::vector<Disk<T>> &disks,
-        std::unordered_map<TransformedVertex, int, TransformedVertexHash> levels,
-        // Visited vertices. Source and sink are never marked as visited; we can visit them multiple times.
-        std::unordered_map<TransformedVertex, bool, TransformedVertexHash> &explored,
-        // Previous vertex in the path (if vertex is on any of paths in given path family which defines residual graph)
-        std::unordered_map<TransformedVertex, TransformedVertex, TransformedVertexHash> prev,
-        std::unordered_map<TransformedVertex, TransformedVertex, TransformedVertexHash> next,
-        TransformedVertex v,
-        int current_level,
-        int sink_level,
-        // Left border (source)
-        const Border<T> &left_border,
-        // Function which tells us if we can get to sink from given disk without any additional hops
-        const std::function<bool(Disk<T>)> &has_edge_to_sink,
-        std::vector<TransformedVertex> &current_path) {
-    // Add vertex to path
-    current_path.push_back(v);
-    std::optional<std::vector<TransformedVertex>> path;
+struct PhaseState {
+    // Used to query intersecting disks, shared by all phases.
+    DataStructure<T> &ds;
+    // views[i] contains disks of inbound vertices of level i which were not deleted yet.
+    // (each worker has its own copy of views, stamps of the views are shared)
+    std::vector<AliveView> views;
+    const std::vector<Disk<T>> &disks;
+    // Levels of vertices.
+    const FindLevelsResult &r;
+    // Previous / next vertex on paths (if vertex is on any of paths in given path family which defines residual graph).
+    const FlowState &flow;
+    // Visited vertices. Source and sink are never marked as visited; we can visit them multiple times.
+    VertexSet &explored;
+    // Left border (source)
+    const Border<T> left_border;
+    // Right border (sink)
+    const Border<T> right_border;
+    // Stack of the DFS. Vertices on the stack form the current path from source.
+    // Kept on the heap and reused between searches, so path length is not limited by the size of the call stack.
+    std::vector<DfsFrame> stack;
+    // Number of explored vertices, reported in statistics.
+    long long explored_count = 0;
+
+    // Mark vertex explored, returns false if it was already explored (by this or some other worker).
+    bool explore(const TransformedVertex &v) {
+        if (!explored.claim(v)) {
+            return false;
+        }
+        explored_count++;
+        return true;
+    }
+
+    // Tells us if we can get to sink from given disk without any additional hops
+    bool has_edge_to_sink(const Disk<T> &disk) const {
+        return intersects<T>(disk, right_border);
+    }
+};
+
+// Find next unexplored child of a vertex on top of the DFS stack in layered residual graph and mark it explored.
+// Returns nothing if all children were already tried.
+template<class T>
+std::optional<TransformedVertex> next_child(PhaseState<T> &state, DfsFrame &frame) {
+    auto &ds = state.ds;
+    auto &views = state.views;
+    const auto &disks = state.disks;
+    const auto &levels = state.r.levels;
+    const auto &prev = state.flow.prev;
+    const auto v = frame.v;
+    const int current_level = frame.level;
+
+    bool started = frame.started;
+    frame.started = true;
 
     if (current_level % 2 == 1) {
-        // Odd level (v is inbound vertex)
+        // Odd level (v is inbound vertex), it has at most one child.
         assert(v.inbound);
 
+        if (started) {
+            return {};
+        }
+
         if (!prev.contains(v)) {
             // Inbound vertex v is not on a path -> continue DFS at outbound vertex of same disk
             auto u = TransformedVertex{v.disk_index, false};
-            if (!explored[u]) {
-                explored[u] = true;
-                path = dfs_explore(ds, disks, levels, explored, prev, next,
-                                   u, current_level + 1,
-                                   sink_level, left_border, has_edge_to_sink, current_path);
+            if (state.explore(u)) {
+                return u;
             }
         } else {
             // Inbound vertex v is on a path -> go back to previous vertex (if not explored yet)
             auto p = prev[v];
-            if (!explored[p]) {
-                // Minor correction of the article: don't always go back in the path. If level is not current_level + 1,
-                // then we are going to vertex which has a level <= current_level. This means that there is a better
-                // path in a tree to this vertex. We don't want to go back to this vertex from here, because then this
-                // won't be a tree anymore.
-                if (levels[p] == current_level + 1) {
-                    explored[p] = true;
-                    path = dfs_explore(ds, disks, levels, explored, prev, next,
-                                       p, current_level + 1,
-                                       sink_level, left_border, has_edge_to_sink, current_path);
-                }
+            // Minor correction of the article: don't always go back in the path. If level is not current_level + 1,
+            // then we are going to vertex which has a level <= current_level. This means that there is a better
+            // path in a tree to this vertex. We don't want to go back to this vertex from here, because then this
+            // won't be a tree anymore.
+            if (levels[p] == current_level + 1 && state.explore(p)) {
+                return p;
             }
         }
-    } else {
-        // Even level (v is outbound vertex)
-        assert(!v.inbound);
+        return {};
+    }
 
-        bool is_source = v == source;
+    // Even level (v is outbound vertex)
+    // This case also includes source vertex (which is always outbound).
+    assert(!v.inbound);
+
+    // First check if v is on a path
+    if (!started && prev.contains(v)) {
+        // Then next vertex is inbound vertex of same disk (go back)
+        auto v_in = TransformedVertex{v.disk_index, true};
+        // Similar as above, do not continue in the path if level is not current_level + 1
+        if (levels[v_in] == current_level + 1 && state.explore(v_in)) {
+            // Remove disk from view[current_level + 1]
+            views[current_level + 1].erase(v.disk_index);
+            return v_in;
+        }
+    }
+
+    // Explore all other connections from v (that are not on paths)
+    // Query data structure for intersecting disks
+    while (true) {
+        // Check if disk of v is intersected by any disk in view[current_level + 1]
+        // If v is source, then compute intersection with left border
+        auto r = v == source
+                 ? ds.intersecting(state.left_border, views[current_level + 1])
+                 : ds.intersecting(disks[v.disk_index], views[current_level + 1]);
+
+        if (!r.has_value()) {
+            // No intersecting disk found, done with this vertex
+            return {};
+        }
+
+        const auto &disk = r.value();
+
+        // Inbound vertex of disk, we have an edge v->u in residual graph.
+        // This edge is not in any path, see article for details.
+        auto u = TransformedVertex{disk.get_index(), true};
+
+        // Remove disk from view
+        views[current_level + 1].erase(disk.get_index());
+
+        // Mark explored
+        if (!state.explore(u)) {
+            // Vertex u is already explored, continue with next disk
+            continue;
+        }
+        return u;
+    }
+}
+
+// DFS from source in layered residual graph, returns next path found from source to sink.
+// Advance / retreat search with an explicit stack: advance to next unexplored child of the vertex on top of the stack,
+// retreat (pop the vertex) if it has none.
+// Search is not restarted for every path, it resumes from the stack left by the previous call (Dinic-style), so the
+// whole phase takes time linear in the number of explored vertices and data structure queries.
+template<class T>
+std::optional<Path> dfs_explore(PhaseState<T> &state) {
+    const auto &disks = state.disks;
+    const auto &next = state.flow.next;
+    const int sink_level = state.r.distance;
+
+    auto &stack = state.stack;
+
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+        const auto v = frame.v;
 
         // First check if we are at last vertex before sink
         // Shortest possible path source -> sink is not considered a path.
-        if (!is_source && current_level == sink_level - 1) {
+        if (v != source && frame.level == sink_level - 1) {
+            assert(!v.inbound);
             // Check if we can get directly to sink
             // - disk of v should be intersected by right border
             // - edge (v, sink) should not be blocked - next[v] should not be sink.
-            if (has_edge_to_sink(disks[v.disk_index]) && next[v] != sink) {
+            if (state.has_edge_to_sink(disks[v.disk_index]) && !next.points_to(v, sink)) {
                 // We can get directly to sink - found path
-                // Copy current_path to path
-                auto p = std::vector<TransformedVertex>(current_path);
-                p.push_back(sink);
+                // Vertices on the stack form the path.
+                Path path;
+                path.reserve(stack.size());
+                for (unsigned int i = 1; i < stack.size(); i++) {
+                    path.push_back(Edge(stack[i - 1].v, stack[i].v));
+                }
+                path.push_back(Edge(v, sink));
 
-                path = {p};
-            }
-        } else {
-            // We are exploring outbound vertex v.
-            // This case also includes source vertex (which is always outbound).
-
-            // First check if v is on a path
-            if (prev.contains(v)) {
-                // Then next vertex is inbound vertex of same disk (go back)
-                auto v_in = TransformedVertex{v.disk_index, true};
-                if (!explored[v_in]) {
-                    // Similar as above, do not continue in the path if level is not current_level + 1
-                    if (levels[v_in] == current_level + 1) {
-                        // Remove disk from data structure[current_level + 1]
-                        ds[current_level + 1]->delete_object(disks[v.disk_index]);
-
-                        explored[v_in] = true;
-                        path = dfs_explore(ds, disks, levels, explored, prev, next,
-                                           v_in, current_level + 1,
-                                           sink_level, left_border, has_edge_to_sink, current_path);
-                    }
+                // Path is saturated: vertices have unit capacities and all vertices on the path are explored, so none
+                // of them can be used again. Retreat to the deepest vertex which can still be extended (only source is
+                // never marked explored) and resume from there in the next call.
+                while (!stack.empty() && stack.back().v != source) {
+                    stack.pop_back();
                 }
+
+                return {path};
             }
 
-            // Explore all other connections from v (that are not on paths)
-            // Query data structure for intersecting disks
+            // Dead end, retreat
+            stack.pop_back();
+            continue;
+        }
 
-            // If nothing found, then explore all other connections from v (if we found path, we won't enter this loop)
-            while (!path.has_value()) {
-                // Check if disk of v is intersected by any disk in data structure[current_level + 1]
-                // If v is source, then compute intersection with left border
-                auto r = is_source
-                         ? ds[current_level + 1]->intersecting(left_border)
-                         : ds[current_level + 1]->intersecting(disks[v.disk_index]);
+        auto u = next_child(state, frame);
+        if (u.has_value()) {
+            // Advance (frame reference is not used after this point)
+            stack.push_back({u.value(), frame.level + 1, false});
+        } else {
+            // Retreat
+            stack.pop_back();
+        }
+    }
 
-                if (!r.has_value()) {
-                    // No intersecting disk found, done with this vertex
-                    break;
-                }
+    return {};
+}
 
-                // Cannot be other than disk (cannot be border)
-                std::variant<Disk<T>, Border<T>> disk_or_border = r.value();
-                auto disk = std::get<Disk<T>>(disk_or_border);
 
-                // Inbound vertex of disk, we have an edge v->u in residual graph.
-                // This edge is not in any path, see article for details.
-                auto u = TransformedVertex{disk.get_index(), true};
+// Build view of the spatial index for each odd level, views[i] contains inbound vertices of level i.
+// Levels are built as independent tasks on the thread pool (if there is one); large levels are split into chunks, so
+// a few huge levels do not leave other threads waiting. Each disk is on a single level, so tasks stamp different disks.
+template<class T>
+std::vector<AliveView> build_level_views(const FindLevelsResult &r, SpatialIndex<T> &index, const Config<T> &config) {
+    using Clock = std::chrono::steady_clock;
 
-                // Remove disk from data structure
-                ds[current_level + 1]->delete_object(disk);
+    auto views = index.empty_views(r.distance + 1);
 
-                if (explored[u]) {
-                    // Vertex u is already explored, continue with next disk
-                    continue;
-                }
+    // Task builds part [begin, end) of a single level.
+    struct BuildTask {
+        int level;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // A little change from the article:
+    // We do not need to build for last level, because it contains only sink (therefore < instead of <=).
+    std::vector<BuildTask> tasks;
+    for (int i = 1; i < r.distance; i += 2) {
+        const auto size = r.levels.vertices_with_level(i).size();
+        for (std::size_t begin = 0; begin < size; begin += parallel_build_chunk_size) {
+            tasks.push_back({i, begin, std::min(size, begin + parallel_build_chunk_size)});
+        }
+    }
 
-                // Mark explored
-                explored[u] = true;
+    const bool measure = config.statistics != nullptr;
+    std::vector<double> task_time(measure ? tasks.size() : 0);
 
-                path = dfs_explore(ds, disks, levels, explored, prev, next,
-                                   u, current_level + 1,
-                                   sink_level, left_border, has_edge_to_sink, current_path);
+    auto build = [&](std::size_t t) {
+        const auto start = measure ? Clock::now() : Clock::time_point();
 
+        const auto &task = tasks[t];
+        const auto &vertices = r.levels.vertices_with_level(task.level);
+        for (std::size_t k = task.begin; k < task.end; k++) {
+            if (vertices[k].inbound) {
+                views[task.level].insert(vertices[k].disk_index);
             }
         }
+
+        if (measure) {
+            task_time[t] = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+    };
+
+    if (index.pool != nullptr && tasks.size() > 1) {
+        index.pool->parallel_for(tasks.size(), build);
+    } else {
+        for (std::size_t t = 0; t < tasks.size(); t++) {
+            build(t);
+        }
     }
 
-    // Remove vertex from path
-    current_path.pop_back();
+    if (measure) {
+        // Report time per level (sum over all tasks of the level)
+        auto &level_build_time = config.statistics->level_build_time;
+        if (level_build_time.size() < views.size()) {
+            level_build_time.resize(views.size(), 0);
+        }
+        for (std::size_t t = 0; t < tasks.size(); t++) {
+            level_build_time[tasks[t].level] += task_time[t];
+        }
+    }
 
-    return path;
+    return views;
 }
 
+} // namespace
 
 template<class T>
 std::vector<Path> find_blocking_family(
-        // Set of edge disjoint paths in G' (multiple paths specified as list of edges)
-        const std::vector<Edge> &blocked_edges,
+        // Set of vertex disjoint paths in G' (current flow)
+        const FlowState &flow,
         // Disks representing the vertices of G
         const std::vector<Disk<T>> &disks,
         // Left and right boundary of the available space
         const T left_border_x,
         const T right_border_x,
-        const Config<T> &config) {
+        // Spatial index built from disks, reused by all phases
+        SpatialIndex<T> &index,
+        const Config<T> &config,
+        VertexLevels *final_levels) {
 
     if (disks.empty()) {
         // No disks -> nothing to find
@@ -164,96 +306,128 @@ std::vector<Path> find_blocking_family(
     }
 
     // First, compute level for each vertex
-    auto r = find_levels<T>(blocked_edges, disks, left_border_x, right_border_x, config);
+    auto r = find_levels<T>(flow, disks, left_border_x, right_border_x, index, config);
 
     if (!r.reachable) {
         // If sink is not reachable, then there is no blocking family (blocking family exits -> it is an empty set)
+        if (final_levels != nullptr) {
+            *final_levels = std::move(r.levels);
+        }
         return {};
     }
 
-    // Group vertices by level
-    std::vector<std::vector<TransformedVertex>> vertices_by_level(r.distance + 1);
-    for (const auto &p: r.levels) {
-        vertices_by_level[p.second].push_back(p.first);
-    }
-
-    // Construct data structure for each odd level
-    // data_structures[i] (for odd i) will contain vertices v_in
-    auto data_structures = std::vector<DataStructure<T> *>(r.distance + 1);
-    for (unsigned int i = 0; i < data_structures.size(); i++) {
-        data_structures[i] = config.data_structure_constructor();
-    }
-
-    // A little change from the article:
-    // We do not need to build for last level, because it contains only sink (therefore < instead of <=).
-    for (int i = 1; i < r.distance; i += 2) {
-        // For each odd i we build a data structure ds for inbound vertices of level i
-        std::vector<GeometryObject<T>> inbound_vertices;
-        for (const auto &v: vertices_by_level[i]) {
-            if (v.inbound) {
-                inbound_vertices.push_back(disks[v.disk_index]);
-            }
-        }
-        data_structures[i]->rebuild(inbound_vertices);
-    }
+    // Construct view of the spatial index for each odd level
+    // views[i] (for odd i) will contain vertices v_in
+    // (no data structure is built, views only stamp disks of the shared index)
+    auto views = build_level_views(r, index, config);
 
     // Find blocking path in layered residual graph.
     // DFS traversal of the graph, starting from the source.
 
-    // We start with new path family
-    std::vector<Path> new_paths;
-    // Which vertices are already explored?
-    std::unordered_map<TransformedVertex, bool, TransformedVertexHash> explored;
-
-    Border<T> right_border = {right_border_x, false};
-    Border<T> left_border = {left_border_x, true};
-
-    std::vector<TransformedVertex> empty_path;
-
-    while (true) {
-        // We perform DFS traversal from the source.
-        // When we get to sink, we have found a path. We add it to the new path family.
-        auto new_path = dfs_explore<T>(
-                data_structures,
+    // Explored vertices are shared by all workers.
+    auto explored = VertexSet(disks.size());
+
+    // Every worker starts DFS at source (level of source is 0) and searches until it runs out of unexplored vertices.
+    // Paths of different workers are vertex disjoint, because each vertex is explored by a single worker. Every
+    // explored vertex ends up either on a found path or as a dead end, so together the paths still form a blocking
+    // family.
+    auto new_worker = [&]() -> PhaseState<T> {
+        return {
+                *index.structure,
+                views,
                 disks,
-                r.levels,
+                r,
+                flow,
                 explored,
-                r.prev,
-                r.next,
-                source,  // Start DFS at source
-                0,  // Level of source is 0
-                r.distance,  // Level of sink is r.distance
-                left_border,
-                [&](const Disk<T> &disk) { return intersects<T>(disk, right_border); },
-                empty_path  // Start with empty path
-        );
-        empty_path.clear(); // Clear path for next iteration
-
-        if (!new_path.has_value()) {
-            // No more paths found
-            break;
+                Border<T>{left_border_x, true},
+                Border<T>{right_border_x, false},
+                {{source, 0, false}},
+        };
+    };
+    auto search = [](PhaseState<T> &state, std::vector<Path> &paths) {
+        while (true) {
+            // We perform DFS traversal from the source.
+            // When we get to sink, we have found a path. We add it to the new path family.
+            auto new_path = dfs_explore<T>(state);
+
+            if (!new_path.has_value()) {
+                // No more paths found
+                break;
+            }
+
+            paths.push_back(std::move(new_path.value()));
         }
+    };
 
-        new_paths.push_back(list_of_vertices_to_path(new_path.value()));
+    // We start with new path family
+    std::vector<Path> new_paths;
+    long long explored_count = 0;
+
+    const bool parallel = index.pool != nullptr && r.distance > 1 &&
+                          r.levels.vertices_with_level(1).size() >= parallel_first_level_size;
+    if (!parallel) {
+        // State shared by all DFS calls in this phase, nothing is copied between steps.
+        auto state = new_worker();
+        search(state, new_paths);
+        explored_count = state.explored_count;
+    } else {
+        const auto workers = static_cast<std::size_t>(index.pool->size());
+        std::vector<std::vector<Path>> worker_paths(workers);
+        std::vector<long long> worker_explored_count(workers);
+
+        index.pool->parallel_for(workers, [&](std::size_t w) {
+            auto state = new_worker();
+            search(state, worker_paths[w]);
+            worker_explored_count[w] = state.explored_count;
+        });
+
+        for (std::size_t w = 0; w < workers; w++) {
+            std::move(worker_paths[w].begin(), worker_paths[w].end(), std::back_inserter(new_paths));
+            explored_count += worker_explored_count[w];
+        }
     }
 
     // If sink is reachable, then there is always a blocking family.
     assert(r.reachable && !new_paths.empty());
 
+    if (config.statistics != nullptr) {
+        config.statistics->explored_vertices += explored_count;
+    }
+
     // Found a blocking family
     return new_paths;
 }
 
-static Path list_of_vertices_to_path(const std::vector<TransformedVertex> &vertices) {
-    Path path;
-    for (unsigned int i = 1; i < vertices.size(); i++) {
-        path.push_back(Edge(vertices[i - 1], vertices[i]));
-    }
-    return path;
+template<class T>
+std::vector<Path> find_blocking_family(
+        const std::vector<Edge> &blocked_edges,
+        const std::vector<Disk<T>> &disks,
+        const T left_border_x,
+        const T right_border_x,
+        const Config<T> &config) {
+    auto index = SpatialIndex<T>(disks, config);
+    return find_blocking_family(FlowState(disks.size(), blocked_edges), disks, left_border_x, right_border_x, index, config);
 }
 
-
 // Force compiler to generate code for these types
+template std::vector<Path> find_blocking_family<int>(
+        const FlowState &flow,
+        const std::vector<Disk<int>> &disks,
+        const int left_border_x,
+        const int right_border_x,
+        SpatialIndex<int> &index,
+        const Config<int> &config,
+        VertexLevels *final_levels);
+
+template std::vector<Path> find_blocking_family<double>(
+        const FlowState &flow,
+        const std::vector<Disk<double>> &disks,
+        const double left_border_x,
+        const double right_border_x,
+        SpatialIndex<double> &index,
+        const Config<double> &config,
+        VertexLevels *final_levels);
+
 template std::vector<Path> find_blocking_family<int>(
         const std::vector<Edge> &blocked_edges,
         const std::vector<Disk<int>> &disks,
@@ -267,4 +441,3 @@ template std::vector<Path> find_blocking_family<double>(
         const double left_border_x,
         const double right_border_x,
         const Config<double> &config);
-
@@ -5,22 +5,39 @@
 #include <ranges>
 #include <optional>
 #include <cassert>
+#include <chrono>
 #include "utils/geometry_objects.hpp"
 #include "utils/transformed_graph.hpp"
 #include "data_structure/data_structure.hpp"
 #include "find_levels.hpp"
+#include "spatial_index.hpp"
+#include "flow_state.hpp"
 #include "config.hpp"
 
 
 template<class T>
 std::vector<Path> find_blocking_family(
-        // Set of edge disjoint paths in G' (multiple paths specified as list of edges)
-        const std::vector<Edge> &blocked_edges,
+        // Set of vertex disjoint paths in G' (current flow)
+        const FlowState &flow,
         // Disks representing the vertices of G
         const std::vector<Disk<T>> &disks,
         // Left and right boundary of the available space
         const T left_border_x,
         const T right_border_x,
+        // Spatial index built from disks, reused by all phases
+        SpatialIndex<T> &index,
+        const Config<T> &config,
+        // If set and the flow is maximum (empty family is returned), levels of vertices reachable from source in the
+        // residual graph are stored here. (min cut can be read from them without running BFS again)
+        VertexLevels *final_levels = nullptr);
+
+// Same as above, but builds its own spatial index and paths are specified as list of edges.
+template<class T>
+std::vector<Path> find_blocking_family(
+        const std::vector<Edge> &blocked_edges,
+        const std::vector<Disk<T>> &disks,
+        const T left_border_x,
+        const T right_border_x,
         const Config<T> &config);
 
 #endif //BARRIER_RESILIENCE_BLOCKING_FAMILY_HPP
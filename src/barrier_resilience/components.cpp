@@ -0,0 +1,237 @@
+#include "components.hpp"
+
+template<class T>
+std::vector<std::vector<int>> border_to_border_components(
+        const std::vector<Disk<T>> &disks,
+        const T &left_border_x,
+        const T &right_border_x,
+        SpatialIndex<T> &index
+) {
+    const auto left_border = Border<T>{left_border_x, true};
+    const auto right_border = Border<T>{right_border_x, false};
+
+    auto &ds = *index.structure;
+    // Disks which were not assigned to any component yet
+    auto unassigned = index.all_disks();
+
+    std::vector<std::vector<int>> components;
+    std::vector<int> stack;
+
+    for (int d = 0; d < static_cast<int>(disks.size()); d++) {
+        if (!unassigned.alive(d)) {
+            continue;
+        }
+
+        // Graph search from disk d, every disk is removed from the view when it is reached, so each disk is found by
+        // a single query.
+        std::vector<int> component = {d};
+        bool touches_left = false;
+        bool touches_right = false;
+
+        unassigned.erase(d);
+        stack.push_back(d);
+
+        while (!stack.empty()) {
+            const auto &disk = disks[stack.back()];
+            stack.pop_back();
+
+            touches_left = touches_left || intersects(disk, left_border);
+            touches_right = touches_right || intersects(disk, right_border);
+
+            while (true) {
+                auto n = ds.intersecting(disk, unassigned);
+                if (!n.has_value()) {
+                    break;
+                }
+
+                unassigned.erase(n.value().get_index());
+                component.push_back(n.value().get_index());
+                stack.push_back(n.value().get_index());
+            }
+        }
+
+        // Component which does not touch both borders contains no path from left to right border
+        if (touches_left && touches_right) {
+            std::sort(component.begin(), component.end());
+            components.push_back(std::move(component));
+        }
+    }
+
+    std::stable_sort(components.begin(), components.end(), [](const auto &a, const auto &b) {
+        return a.size() > b.size();
+    });
+
+    return components;
+}
+
+template<class T>
+std::vector<int> border_to_border_chain_disks(
+        const std::vector<Disk<T>> &disks,
+        const T &left_border_x,
+        const T &right_border_x,
+        SpatialIndex<T> &index
+) {
+    const auto left_border = Border<T>{left_border_x, true};
+    const auto right_border = Border<T>{right_border_x, false};
+
+    auto &ds = *index.structure;
+    // View used to enumerate neighbours, found disks are erased and inserted back after the enumeration
+    auto neighbour_view = index.all_disks();
+
+    // Vertices of the graph are disks (0..n-1) and both borders
+    const int n = static_cast<int>(disks.size());
+    const int left = n;
+    const int right = n + 1;
+
+    // All neighbours of vertex v
+    auto neighbours = [&](int v) {
+        std::vector<int> result;
+        auto enumerate = [&](const GeometryObject<T> &object, AliveView &view) {
+            while (true) {
+                auto u = ds.intersecting(object, view);
+                if (!u.has_value()) {
+                    break;
+                }
+                view.erase(u.value().get_index());
+                result.push_back(u.value().get_index());
+            }
+        };
+
+        if (v == left || v == right) {
+            // Border queries assume that disks are never inserted back to the view, so they get a new one
+            // (there are only two of them).
+            auto view = index.all_disks();
+            enumerate(v == left ? GeometryObject<T>(left_border) : GeometryObject<T>(right_border), view);
+            return result;
+        }
+
+        neighbour_view.erase(v);
+        enumerate(disks[v], neighbour_view);
+        neighbour_view.insert(v);
+
+        if (intersects(disks[v], left_border)) {
+            result.push_back(left);
+        }
+        if (intersects(disks[v], right_border)) {
+            result.push_back(right);
+        }
+
+        for (auto u: result) {
+            if (u < n) {
+                neighbour_view.insert(u);
+            }
+        }
+        return result;
+    };
+
+    // Depth first search from the left border computing discovery times and low points (Tarjan).
+    // Every vertex except the left border is assigned to a block, the block is identified by its topmost tree edge
+    // (parent -> head), head is stored for each block.
+    std::vector<int> discovery(n + 2, -1);
+    std::vector<int> low(n + 2);
+    std::vector<int> parent(n + 2, -1);
+    std::vector<int> block_of(n + 2, -1);
+    std::vector<int> block_head;
+
+    struct Frame {
+        int vertex;
+        // Neighbours which were unvisited when vertex was discovered (possible children)
+        std::vector<int> children;
+        std::size_t next_child = 0;
+    };
+
+    std::vector<Frame> dfs_stack;
+    // Vertices which were not assigned to a block yet
+    std::vector<int> block_stack;
+    int time = 0;
+
+    auto discover = [&](int v) {
+        discovery[v] = low[v] = time++;
+        block_stack.push_back(v);
+
+        Frame frame = {v, {}};
+        for (auto u: neighbours(v)) {
+            if (discovery[u] == -1) {
+                frame.children.push_back(u);
+            } else {
+                // Back edge (or edge to parent, which does not change articulation points)
+                low[v] = std::min(low[v], discovery[u]);
+            }
+        }
+        dfs_stack.push_back(std::move(frame));
+    };
+
+    discover(left);
+    while (!dfs_stack.empty()) {
+        auto &frame = dfs_stack.back();
+        const int v = frame.vertex;
+
+        if (frame.next_child < frame.children.size()) {
+            const int u = frame.children[frame.next_child++];
+            // Child could have been discovered from another subtree in the meantime, then the edge is a back edge
+            // and it was already taken into account when u was discovered.
+            if (discovery[u] == -1) {
+                parent[u] = v;
+                discover(u);
+            }
+            continue;
+        }
+
+        // All children are done
+        dfs_stack.pop_back();
+        const int p = parent[v];
+        if (p == -1) {
+            continue;
+        }
+
+        low[p] = std::min(low[p], low[v]);
+        if (low[v] >= discovery[p]) {
+            // p separates subtree of v from the rest of the graph, vertices of the subtree still on the stack form
+            // a block together with p
+            const int block = static_cast<int>(block_head.size());
+            block_head.push_back(v);
+            while (true) {
+                const int u = block_stack.back();
+                block_stack.pop_back();
+                block_of[u] = block;
+                if (u == v) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (discovery[right] == -1) {
+        // There is no chain from left to right border
+        return {};
+    }
+
+    // Vertices on the tree path from left to right border. Every simple chain goes through the same blocks as this
+    // path, so a block is on some chain exactly when its head is on the path.
+    std::vector<bool> on_path(n + 2, false);
+    for (int v = right; v != -1; v = parent[v]) {
+        on_path[v] = true;
+    }
+
+    std::vector<int> chain_disks;
+    for (int d = 0; d < n; d++) {
+        if (block_of[d] != -1 && on_path[block_head[block_of[d]]]) {
+            chain_disks.push_back(d);
+        }
+    }
+
+    return chain_disks;
+}
+
+// Force compiler to instantiate the template for the types we need
+template std::vector<std::vector<int>> border_to_border_components<int>(const std::vector<Disk<int>> &disks,
+        const int &left_border_x, const int &right_border_x, SpatialIndex<int> &index);
+
+template std::vector<std::vector<int>> border_to_border_components<double>(const std::vector<Disk<double>> &disks,
+        const double &left_border_x, const double &right_border_x, SpatialIndex<double> &index);
+
+template std::vector<int> border_to_border_chain_disks<int>(const std::vector<Disk<int>> &disks,
+        const int &left_border_x, const int &right_border_x, SpatialIndex<int> &index);
+
+template std::vector<int> border_to_border_chain_disks<double>(const std::vector<Disk<double>> &disks,
+        const double &left_border_x, const double &right_border_x, SpatialIndex<double> &index);
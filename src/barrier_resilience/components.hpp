@@ -0,0 +1,42 @@
+#ifndef BARRIER_RESILIENCE_COMPONENTS_HPP
+#define BARRIER_RESILIENCE_COMPONENTS_HPP
+
+#include <vector>
+#include <algorithm>
+#include "utils/geometry_objects.hpp"
+#include "spatial_index.hpp"
+
+// Connected components of the intersection graph of disks which touch both borders.
+// Every path from left to right border lies in a single component and components which do not touch both borders
+// have no path at all, so the barrier resilience is the sum of barrier resiliences of returned components.
+// Components are returned as lists of disk indices (in increasing order), largest component first.
+template<class T>
+std::vector<std::vector<int>> border_to_border_components(
+        // Disks with indices set
+        const std::vector<Disk<T>> &disks,
+        // Left and right boundary of the available space
+        const T &left_border_x,
+        const T &right_border_x,
+        // Spatial index built from disks
+        SpatialIndex<T> &index
+);
+
+// Disks which lie on some simple chain of intersecting disks from left to right border (in increasing order).
+// Other disks (dead ends hanging off the chains, e.g. a branch attached to a chain by a single disk) are in no minimum
+// cut and on no vertex-disjoint path, so they can be removed before the flow computation. Components which do not
+// touch both borders are removed as well.
+// Disks on simple chains are exactly the disks of biconnected blocks on the path between the left and the right border
+// in the block-cut tree of the intersection graph (with both borders as extra vertices). All neighbours of every disk
+// are enumerated, so this takes O(number of intersecting pairs) queries.
+template<class T>
+std::vector<int> border_to_border_chain_disks(
+        // Disks with indices set
+        const std::vector<Disk<T>> &disks,
+        // Left and right boundary of the available space, should not intersect
+        const T &left_border_x,
+        const T &right_border_x,
+        // Spatial index built from disks
+        SpatialIndex<T> &index
+);
+
+#endif //BARRIER_RESILIENCE_COMPONENTS_HPP
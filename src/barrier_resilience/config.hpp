@@ -4,6 +4,11 @@
 #include "data_structure/data_structure.hpp"
 #include "data_structure/trivial.hpp"
 #include "data_structure/kdtree.hpp"
+#include "data_structure/cgal_kdtree.hpp"
+#include "data_structure/grid.hpp"
+#include "data_structure/hierarchical_grid.hpp"
+#include "data_structure/bvh.hpp"
+#include "statistics.hpp"
 #include "functional"
 
 template<class T>
@@ -11,6 +16,36 @@ struct Config {
     // Constructor function for data structure.
     std::function<DataStructure<T> *()> data_structure_constructor;
 
+    // If set, solver counters are accumulated into this object.
+    Statistics *statistics = nullptr;
+
+    // Number of threads used by parallel steps of the solver (1 = everything runs on the calling thread).
+    int threads = 1;
+
+    // If set, levels computed by BFS are pruned by a backward BFS from sink to vertices on shortest paths from source
+    // to sink (other vertices are dead ends for DFS in the blocking family search).
+    bool shortest_path_pruning = false;
+
+    // If set, BFS computes large layers bottom-up (unvisited disks are tested against a data structure built from the
+    // last layer) instead of top-down, see expand_bottom_up in find_levels.
+    bool direction_optimizing_bfs = false;
+
+    // If set, connected components of the intersection graph which touch both borders are solved separately (and in
+    // parallel, if threads > 1), other components are dropped.
+    bool split_components = false;
+
+    // If set, disks which are not on any chain from left to right border are removed before the flow computation,
+    // see border_to_border_chain_disks.
+    bool prune_dead_ends = false;
+
+    // If set, the flow starts from a greedy packing of disjoint chains (see greedy_path_packing) instead of the empty
+    // flow, so the phases only have to find the remaining paths.
+    bool warm_start = false;
+
+    // If set, phases which find only a few paths are followed by searches for single augmenting paths (see
+    // find_augmenting_path), switch threshold is adapted to measured cost of both.
+    bool hybrid_phases = false;
+
     static Config<T> with_trivial_datastructure() {
         return Config<T>{
                 []() -> DataStructure<T> * {
@@ -26,6 +61,39 @@ struct Config {
                 }
         };
     }
+
+    // Kd-tree from CGAL, reference for KDTree.
+    static Config<T> with_cgal_kdtree() {
+        return Config<T>{
+                []() -> DataStructure<T> * {
+                    return new CGALKDTree<T>();
+                }
+        };
+    }
+
+    static Config<T> with_grid() {
+        return Config<T>{
+                []() -> DataStructure<T> * {
+                    return new Grid<T>();
+                }
+        };
+    }
+
+    static Config<T> with_hierarchical_grid() {
+        return Config<T>{
+                []() -> DataStructure<T> * {
+                    return new HierarchicalGrid<T>();
+                }
+        };
+    }
+
+    static Config<T> with_bvh() {
+        return Config<T>{
+                []() -> DataStructure<T> * {
+                    return new BVH<T>();
+                }
+        };
+    }
 };
 
 
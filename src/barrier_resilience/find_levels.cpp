@@ -1,43 +1,309 @@
 #include "find_levels.hpp"
 
+// BFS expansion helpers are local to this file.
+namespace {
+
+// Layers with fewer outbound vertices are expanded on a single thread.
+const std::size_t parallel_layer_size = 1024;
+// Number of outbound vertices expanded by a single task.
+const std::size_t parallel_chunk_size = 128;
+// Odd layer is computed bottom-up if size of the last layer times this ratio is larger than number of unvisited disks.
+const std::size_t bottom_up_ratio = 4;
+
+// Add inbound vertices of unvisited disks intersecting the disk of outbound vertex v to neighbors and remove the disks
+// from unvisited. Can be called from multiple threads at once, each disk is claimed by exactly one call.
+template<class T>
+void expand_outbound_vertex(
+        const TransformedVertex &v,
+        std::vector<TransformedVertex> &neighbors,
+        const std::vector<Disk<T>> &disks,
+        const VertexLinks &next,
+        DataStructure<T> &ds,
+        AliveView &unvisited
+) {
+    // Query data structure for disks intersecting with the disk, remove them from the view
+    while (true) {
+        auto n = ds.intersecting(disks[v.disk_index], unvisited);
+
+        if (!n.has_value()) {
+            // If there are no disks intersecting with the disk, we are done.
+            break;
+        }
+
+        if (!unvisited.claim(n.value().get_index())) {
+            // Other thread claimed the disk first
+            continue;
+        }
+
+        auto u = disk_to_transformed_vertex(n.value(), true);
+
+        // If v_outbound lies on some path, graph L contains reverse edge v_outbound -> prev[v_outbound] = u_inbound
+        // In this case, we need to ignore v_outbound -> next[v_outbound] edge.
+        if (next.points_to(v, u)) {
+            // Ignore edge v_outbound -> next[v_outbound]
+            // Reverse edge is v_outbound -> v_inbound. We already added v_inbound to the layer L[i - 2],
+            // (v is in layer L[i - 2]) so we do not need to do anything.
+            continue;
+        }
+
+        neighbors.push_back(u);
+    }
+}
+
+// Compute odd layer L[i] from outbound vertices of the last layer L[i - 1].
+// Returns true if sink is in L[i] (in that case, current layer is not complete).
+// Every unvisited disk is claimed by exactly one outbound vertex, so the same vertices end up in L[i] whether the layer
+// is expanded on one or on multiple threads (only their order can differ).
+template<class T>
+bool expand_outbound_vertices(
+        const std::vector<TransformedVertex> &last_layer_vertices,
+        std::vector<TransformedVertex> &current_layer_vertices,
+        const std::vector<Disk<T>> &disks,
+        const Border<T> &right_border,
+        const VertexLinks &next,
+        DataStructure<T> &ds,
+        AliveView &unvisited,
+        ThreadPool *pool
+) {
+    std::vector<TransformedVertex> outbound_vertices;
+    for (const auto &v: last_layer_vertices) {
+        if (!v.inbound) {
+            outbound_vertices.push_back(v);
+        }
+    }
+
+    if (pool == nullptr || outbound_vertices.size() < parallel_layer_size) {
+        for (const auto &v: outbound_vertices) {
+            // If the disk intersects the right border, we found the sink
+            if (intersects(disks[v.disk_index], right_border)) {
+                return true;
+            }
+            expand_outbound_vertex(v, current_layer_vertices, disks, next, ds, unvisited);
+        }
+        return false;
+    }
+
+    // Level-synchronous parallel expansion, chunks of the layer are expanded by different threads.
+    const std::size_t chunks = (outbound_vertices.size() + parallel_chunk_size - 1) / parallel_chunk_size;
+    std::vector<std::vector<TransformedVertex>> chunk_neighbors(chunks);
+    std::atomic<bool> found_sink = false;
+
+    pool->parallel_for(chunks, [&](std::size_t chunk) {
+        const std::size_t end = std::min(outbound_vertices.size(), (chunk + 1) * parallel_chunk_size);
+        for (std::size_t k = chunk * parallel_chunk_size; k < end; k++) {
+            if (found_sink.load(std::memory_order_relaxed)) {
+                // Some other thread found the sink, layer will be thrown away
+                return;
+            }
+
+            const auto &v = outbound_vertices[k];
+            if (intersects(disks[v.disk_index], right_border)) {
+                found_sink.store(true, std::memory_order_relaxed);
+                return;
+            }
+            expand_outbound_vertex(v, chunk_neighbors[chunk], disks, next, ds, unvisited);
+        }
+    });
+
+    if (found_sink.load()) {
+        return true;
+    }
+
+    // Merge neighbors in order of chunks
+    for (const auto &neighbors: chunk_neighbors) {
+        current_layer_vertices.insert(current_layer_vertices.end(), neighbors.begin(), neighbors.end());
+    }
+    return false;
+}
+
+// Compute odd layer L[i] bottom-up: build a small data structure from disks of the outbound vertices of the last layer
+// L[i - 1] and query it with every unvisited disk. This is cheaper than top-down (querying unvisited disks with every
+// vertex of the last layer) when the last layer is large compared to the number of unvisited disks.
+// Works with any data structure, new one is constructed by Config::data_structure_constructor.
+// Returns true if sink is in L[i] (in that case, current layer is not complete).
+template<class T>
+bool expand_bottom_up(
+        const std::vector<TransformedVertex> &last_layer_vertices,
+        std::vector<TransformedVertex> &current_layer_vertices,
+        const std::vector<Disk<T>> &disks,
+        const Border<T> &right_border,
+        AliveView &unvisited,
+        std::vector<int> &unvisited_disks,
+        const Config<T> &config
+) {
+    std::vector<GeometryObject<T>> frontier;
+    for (const auto &v: last_layer_vertices) {
+        if (v.inbound) {
+            continue;
+        }
+        // If the disk intersects the right border, we found the sink
+        if (intersects(disks[v.disk_index], right_border)) {
+            return true;
+        }
+        frontier.push_back(disks[v.disk_index]);
+    }
+
+    std::unique_ptr<DataStructure<T>> ds(config.data_structure_constructor());
+    ds->rebuild(frontier);
+
+    // Go over disks which might be unvisited, drop those visited in the meantime
+    std::size_t kept = 0;
+    for (auto d: unvisited_disks) {
+        if (!unvisited.alive(d)) {
+            continue;
+        }
+
+        if (ds->intersecting(disks[d]).has_value()) {
+            // Edge v_outbound -> d_inbound is never on a path here: outbound vertex on a path is reached only from
+            // the next vertex on its path, which already has a level (and d does not).
+            unvisited.erase(d);
+            current_layer_vertices.push_back({d, true});
+        } else {
+            unvisited_disks[kept++] = d;
+        }
+    }
+    unvisited_disks.resize(kept);
+
+    return false;
+}
+
+// Backward BFS from sink over the layered residual graph: keep only vertices which lie on some shortest path from
+// source to sink (vertex v with level l is kept if it has an edge to a kept vertex with level l + 1).
+// Other vertices are dead ends for DFS in find_blocking_family, so they do not need to be loaded into views of levels
+// nor explored.
+template<class T>
+VertexLevels shortest_path_levels(
+        const VertexLevels &levels,
+        int distance,
+        const std::vector<Disk<T>> &disks,
+        const Border<T> &right_border,
+        const FlowState &flow,
+        SpatialIndex<T> &index,
+        Statistics *statistics
+) {
+    const auto &prev = flow.prev;
+    const auto &next = flow.next;
+    auto &ds = *index.structure;
+
+    auto on_shortest_path = VertexSet(disks.size());
+
+    // Last level before sink - outbound vertices with an edge to sink, edge should not be blocked
+    for (const auto &v: levels.vertices_with_level(distance - 1)) {
+        if (intersects(disks[v.disk_index], right_border) && !next.points_to(v, sink)) {
+            on_shortest_path.insert(v);
+        }
+    }
+
+    for (int l = distance - 2; l >= 1; l--) {
+        if (l % 2 == 1) {
+            // Inbound vertex v has a single edge, to v_outbound if v is not on a path, otherwise to prev[v]
+            for (const auto &v: levels.vertices_with_level(l)) {
+                auto child = prev.contains(v) ? prev[v] : TransformedVertex{v.disk_index, false};
+                if (levels[child] == l + 1 && on_shortest_path.contains(child)) {
+                    on_shortest_path.insert(v);
+                }
+            }
+            continue;
+        }
+
+        // Outbound vertices of level l which were not kept yet.
+        auto view = index.empty_views(1)[0];
+        for (const auto &v: levels.vertices_with_level(l)) {
+            view.insert(v.disk_index);
+        }
+
+        // Go over kept inbound vertices u of level l + 1 and keep outbound vertices with an edge to u
+        for (const auto &u: levels.vertices_with_level(l + 1)) {
+            if (!on_shortest_path.contains(u)) {
+                continue;
+            }
+
+            // Outbound vertex of the same disk has edge to u if it is on a path
+            auto u_out = TransformedVertex{u.disk_index, false};
+            if (levels[u_out] == l && prev.contains(u_out) && !on_shortest_path.contains(u_out)) {
+                on_shortest_path.insert(u_out);
+                view.erase(u_out.disk_index);
+            }
+
+            // Outbound vertices of intersecting disks have edge to u, except for the edge on a path (next[v] = u)
+            std::optional<TransformedVertex> blocked;
+            while (true) {
+                auto n = ds.intersecting(disks[u.disk_index], view);
+                if (!n.has_value()) {
+                    break;
+                }
+
+                view.erase(n.value().get_index());
+                auto v = TransformedVertex{n.value().get_index(), false};
+                if (next.points_to(v, u)) {
+                    // v can still have edge to other vertices of level l + 1
+                    blocked = v;
+                    continue;
+                }
+                on_shortest_path.insert(v);
+            }
+            if (blocked.has_value()) {
+                view.insert(blocked.value().disk_index);
+            }
+        }
+    }
+
+    // Source and sink are always kept, other vertices only if they are on some shortest path
+    auto pruned = VertexLevels(disks.size());
+    pruned.set(source, 0);
+    for (int l = 1; l < distance; l++) {
+        for (const auto &v: levels.vertices_with_level(l)) {
+            if (on_shortest_path.contains(v)) {
+                pruned.set(v, l);
+            }
+        }
+    }
+    pruned.set(sink, distance);
+
+    if (statistics != nullptr) {
+        statistics->pruned_level_vertices += levels.size() - pruned.size();
+    }
+
+    return pruned;
+}
+
+} // namespace
+
 template<class T>
 FindLevelsResult find_levels(
-        // Set of edge disjoint paths in G'.
-        // (actually just a array of edges in G' which are on some path)
-        const std::vector<Edge> &blocked_edges,
+        // Set of vertex disjoint paths in G' (current flow).
+        const FlowState &flow,
         // Disks representing the vertices of G
         const std::vector<Disk<T>> &disks,
         // Left and right boundary of the available space
         const T &left_border_x,
         const T &right_border_x,
+        // Spatial index built from disks
+        SpatialIndex<T> &index,
         const Config<T> &config
 ) {
-    auto levels = std::unordered_map<TransformedVertex, int, TransformedVertexHash>();
-    std::vector<bool> used_disks(disks.size(), false);
+    auto levels = VertexLevels(disks.size());
 
     const auto left_border = Border<T>{left_border_x, true};
     const auto right_border = Border<T>{right_border_x, false};
 
-    // Preprocessing: for every vertex on any of the paths, mark previous and next vertex on the path.
-    std::unordered_map<TransformedVertex, TransformedVertex, TransformedVertexHash> prev;
-    std::unordered_map<TransformedVertex, TransformedVertex, TransformedVertexHash> next;
-
-    for (const auto e: blocked_edges) {
-        // Add previous vertex
-        prev[e.to] = e.from;
-        // Add next vertex
-        next[e.from] = e.to;
-    }
+    // Previous and next vertex on the paths are kept up to date by the flow, no preprocessing is needed.
+    const auto &prev = flow.prev;
+    const auto &next = flow.next;
 
     // First layer - layer 0 - level of source is 0
-    levels[source] = 0;
+    levels.set(source, 0);
 
-    // Construct data structure from disks and sink.
-    std::vector<GeometryObject<T>> objects(disks.begin(), disks.end());
-    objects.push_back(right_border);
+    // Sink is not stored in the data structure, edges to sink are checked directly.
+    // If left border intersects right border, we found the sink and we are done.
+    if (intersects(left_border, right_border)) {
+        levels.set(sink, 1);
+        return {std::move(levels), true, 1};
+    }
 
-    DataStructure<T> * ds = config.data_structure_constructor();
-    ds->rebuild(objects);
+    // Disks not reached yet. Instead of constructing a new data structure, we use a fresh view of the spatial index.
+    auto &ds = *index.structure;
+    auto unvisited = index.all_disks();
 
     // Find layer 1 - query datastructure for disks intersecting with the left border
     std::vector<Disk<T>> u_neighbors;
@@ -45,31 +311,16 @@ FindLevelsResult find_levels(
 
     while (true) {
         // Find disk intersecting with the left border
-        auto n = ds->intersecting(left_border);
-
-        if (n.has_value()) {
-            const GeometryObject<T> o = n.value();
-            // Remove object from data structure
-            ds->delete_object(o);
+        auto n = ds.intersecting(left_border, unvisited);
 
-            // If the object is a disk, add it to the list of neighbors
-            if (is_disk(o)) {
-                u_neighbors.push_back(std::get<Disk<T>>(o));
-            } else {
-                // If the object is a border, we found the sink.
-                found_sink = true;
-                break;
-            }
-        } else {
+        if (!n.has_value()) {
             // If there are no disks intersecting with the left border, we are done.
             break;
         }
-    }
 
-    // If we found the sink, we are done.
-    if (found_sink) {
-        levels[sink] = 1;
-        return {levels, true, 1, prev, next};
+        // Remove disk from the view and add it to the list of neighbors
+        unvisited.erase(n.value().get_index());
+        u_neighbors.push_back(n.value());
     }
 
     // Convert neighboring geometry objects to inbound vertices (there are only inbound vertices on layer 1)
@@ -83,26 +334,30 @@ FindLevelsResult find_levels(
                                        u_neighbors_vertices.begin(), u_neighbors_vertices.end(),
                                        [&prev](const auto &v) {
                                            // Check if v is in path and has previous vertex s
-                                           return prev.find(v) != prev.end() && prev[v] == source;
+                                           return prev.points_to(v, source);
                                        }),
                                u_neighbors_vertices.end());
 
     // Add vertices to the list of vertices on layer 1
     for (const auto &v: u_neighbors_vertices) {
-        levels[v] = 1;
-        // Mark disk as used
-        used_disks[v.disk_index] = true;
+        levels.set(v, 1);
     }
 
-    // Reconstruct data structure from remaining disks and sink.
-    objects = {};
-    for (unsigned int i = 0; i < disks.size(); i++) {
-        if (!used_disks[i]) {
-            objects.push_back(disks[i]);
+    // Filtered disks are not used yet, add them back to the view (no need to reconstruct the data structure).
+    for (const auto &d: u_neighbors) {
+        if (!levels.contains(disk_to_transformed_vertex(d, true))) {
+            unvisited.insert(d.get_index());
         }
     }
-    objects.push_back(right_border);
-    ds->rebuild(objects);
+
+    // Number of disks whose inbound vertex has a level (these are not in the unvisited view).
+    std::size_t visited_disks = u_neighbors_vertices.size();
+    // Disks which might still be unvisited, used by bottom-up layers (visited disks are dropped by each of them).
+    std::vector<int> unvisited_disks;
+    if (config.direction_optimizing_bfs) {
+        unvisited_disks.resize(disks.size());
+        std::iota(unvisited_disks.begin(), unvisited_disks.end(), 0);
+    }
 
     // Last layer, L[i - 1]
     std::vector<TransformedVertex> last_layer_vertices = u_neighbors_vertices;
@@ -123,94 +378,56 @@ FindLevelsResult find_levels(
 
                 // - if inbound vertex lies on some path, graph L contains reverse edge prev[v_inbound] -> v_inbound
                 // - if inbound vertex does not lie on a path, we can add v_outbound to L[i]
-                if (prev.find(v) != prev.end()) {
+                if (prev.contains(v)) {
                     auto u = prev[v];
-                    if (u == source) {
-                        // We do not need to do anything, since we already added source to L[0]
+                    if (levels.contains(u)) {
+                        // We do not need to do anything, u already has a lower level.
+                        // (this also covers the source, which is already in L[0])
                     } else {
                         // We add u to current layer
-                        levels[u] = i;
+                        levels.set(u, i);
                         current_layer_vertices.push_back(u);
                     }
                 } else {
                     // Add outbound vertex to the graph and to the current layer
-                    levels[{v.disk_index, false}] = i;
+                    levels.set({v.disk_index, false}, i);
                     current_layer_vertices.push_back({v.disk_index, false});
                 }
             }
         } else {
-            // If i is odd, we iterate over the outbound vertices of the last layer
-            for (auto v: last_layer_vertices) {
-                if (v.inbound) {
-                    continue;
-                }
-
-                std::vector<Disk<T>> neighbors;
-
-                // Query data structure for objects intersecting with the disk
-                while (true) {
-                    auto n = ds->intersecting(disks[v.disk_index]);
-
-                    if (n.has_value()) {
-                        const GeometryObject<T> o = n.value();
-                        // Remove object from data structure
-                        ds->delete_object(o);
-
-                        // If the object is a disk, add it to the list of neighbors
-                        if (is_disk(o)) {
-                            neighbors.push_back(std::get<Disk<T>>(o));
-                        } else {
-                            // If the object is a border, we found the sink.
-                            found_sink = true;
-                            levels[sink] = i;
-                            break;
-                        }
-                    } else {
-                        // If there are no disks intersecting with the disk, we are done.
-                        break;
-                    }
-                }
-
-                // If we found the sink - clear what we did in current layer and break
-                if (found_sink) {
-                    for (const auto &v: current_layer_vertices) {
-                        levels.erase(v);
-                    }
-                    current_layer_vertices.clear();
-                    break;
-                }
-
-                // If there are no neighbors, go to the next vertex
-                if (neighbors.empty()) {
-                    continue;
-                }
+            // If i is odd, we expand outbound vertices of the last layer.
+            // Direction is chosen by size of the last layer and number of disks which were not visited yet.
+            const auto remaining_disks = disks.size() - visited_disks;
+            const bool bottom_up = config.direction_optimizing_bfs &&
+                                   last_layer_vertices.size() * bottom_up_ratio > remaining_disks;
+
+            if (bottom_up) {
+                found_sink = expand_bottom_up(last_layer_vertices, current_layer_vertices, disks, right_border,
+                                              unvisited, unvisited_disks, config);
+            } else {
+                // Iterate over the outbound vertices of the last layer
+                found_sink = expand_outbound_vertices(last_layer_vertices, current_layer_vertices, disks,
+                                                      right_border, next, ds, unvisited, index.pool);
+            }
+            visited_disks += current_layer_vertices.size();
 
-                // Convert neighboring geometry objects to inbound vertices
-                std::vector<TransformedVertex> neighbors_vertices(neighbors.size());
-                std::transform(neighbors.begin(), neighbors.end(), neighbors_vertices.begin(), [](const auto &d) {
-                    return disk_to_transformed_vertex(d, true);
-                });
-
-                // If v_outbound lies on some path, graph L contains reverse edge v_outbound -> prev[v_outbound] = u_inbound
-                // In this case, we need to ignore v_outbound -> next[v_outbound] edge.
-                bool has_next = next.find(v) != next.end();
-                for (const auto &u: neighbors_vertices) {
-                    if (has_next && next[v] == u) {
-                        // Ignore edge v_outbound -> next[v_outbound]
-                        // Reverse edge is v_outbound -> v_inbound. We already added v_inbound to the layer L[i - 2],
-                        // (v is in layer L[i - 2]) so we do not need to do anything.
-                        continue;
-                    }
+            if (config.statistics != nullptr) {
+                (bottom_up ? config.statistics->bottom_up_layers : config.statistics->top_down_layers)++;
+            }
 
-                    // Add u to current layer
-                    levels[u] = i;
-                    current_layer_vertices.push_back(u);
+            if (found_sink) {
+                // We found the sink - clear what we did in current layer
+                current_layer_vertices.clear();
+                levels.set(sink, i);
+            } else {
+                for (const auto &u: current_layer_vertices) {
+                    levels.set(u, i);
                 }
             }
         }
 
         i++;
-        last_layer_vertices = current_layer_vertices;
+        last_layer_vertices.swap(current_layer_vertices);
     }
 
     int distance;
@@ -220,10 +437,33 @@ FindLevelsResult find_levels(
         distance = -1;
     }
 
-    return {levels, found_sink, distance, prev, next};
+    if (found_sink && config.shortest_path_pruning) {
+        levels = shortest_path_levels(levels, distance, disks, right_border, flow, index, config.statistics);
+    }
+
+    return {std::move(levels), found_sink, distance};
+}
+
+template<class T>
+FindLevelsResult find_levels(
+        const std::vector<Edge> &blocked_edges,
+        const std::vector<Disk<T>> &disks,
+        const T &left_border_x,
+        const T &right_border_x,
+        const Config<T> &config
+) {
+    auto index = SpatialIndex<T>(disks, config);
+    return find_levels(FlowState(disks.size(), blocked_edges), disks, left_border_x, right_border_x, index, config);
 }
 
 // Force compiler to instantiate the template for the types we need
+template FindLevelsResult find_levels<int>(const FlowState &flow, const std::vector<Disk<int>> &disks,
+        const int &left_border_x, const int &right_border_x, SpatialIndex<int> &index, const Config<int> &config);
+
+template FindLevelsResult find_levels<double>(const FlowState &flow, const std::vector<Disk<double>> &disks,
+        const double &left_border_x, const double &right_border_x, SpatialIndex<double> &index,
+        const Config<double> &config);
+
 template FindLevelsResult find_levels<int>(const std::vector<Edge> &blocked_edges, const std::vector<Disk<int>> &disks,
         const int &left_border_x, const int &right_border_x, const Config<int> &config);
 
@@ -0,0 +1,61 @@
+#ifndef BARRIER_RESILIENCE_FLOW_STATE_HPP
+#define BARRIER_RESILIENCE_FLOW_STATE_HPP
+
+#include <vector>
+#include "utils/transformed_graph.hpp"
+#include "utils/vertex_state.hpp"
+
+// Current flow in G' (set of vertex disjoint paths from source to sink).
+// Vertices of G' have unit capacities, so every vertex (except source and sink) has at most one previous and at most
+// one next vertex on the paths. Flow is kept in two arrays which are updated in place when a path is augmented, so
+// nothing needs to be rebuilt between phases.
+// Warning: next[source] and prev[sink] might be incorrect (there can be multiple paths from source to sink).
+struct FlowState {
+    // Previous vertex on a path, for every vertex on any of the paths.
+    VertexLinks prev;
+    // Next vertex on a path, for every vertex on any of the paths.
+    VertexLinks next;
+
+    FlowState() = default;
+
+    // Empty flow.
+    explicit FlowState(int number_of_disks) : prev(number_of_disks), next(number_of_disks) {}
+
+    // Flow given as a set of edges which are on some path.
+    FlowState(int number_of_disks, const std::vector<Edge> &edges) : FlowState(number_of_disks) {
+        for (const auto &e: edges) {
+            prev.set(e.to, e.from);
+            next.set(e.from, e.to);
+        }
+    }
+
+    // Is edge v -> u on some path?
+    bool contains(const Edge &e) const {
+        return next.points_to(e.from, e.to) && prev.points_to(e.to, e.from);
+    }
+
+    // Add a path found in residual graph to the flow, in O(length of the path).
+    // Edges of the path which go against the flow cancel the flow edge (direct sum of the flow and the path).
+    void augment(const Path &path) {
+        // First remove cancelled edges, then add new ones. Otherwise, removing a cancelled edge could erase a link which
+        // was just set by an earlier edge of the same path (path can enter a vertex by a new edge and leave it against
+        // the flow).
+        std::vector<bool> cancelled(path.size(), false);
+        for (unsigned int i = 0; i < path.size(); i++) {
+            const auto reverse_edge = Edge(path[i].to, path[i].from);
+            if (contains(reverse_edge)) {
+                next.erase(reverse_edge.from);
+                prev.erase(reverse_edge.to);
+                cancelled[i] = true;
+            }
+        }
+        for (unsigned int i = 0; i < path.size(); i++) {
+            if (!cancelled[i]) {
+                next.set(path[i].from, path[i].to);
+                prev.set(path[i].to, path[i].from);
+            }
+        }
+    }
+};
+
+#endif //BARRIER_RESILIENCE_FLOW_STATE_HPP
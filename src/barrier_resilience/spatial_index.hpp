@@ -0,0 +1,71 @@
+#ifndef BARRIER_RESILIENCE_SPATIAL_INDEX_HPP
+#define BARRIER_RESILIENCE_SPATIAL_INDEX_HPP
+
+#include <vector>
+#include <memory>
+#include "utils/geometry_objects.hpp"
+#include "data_structure/data_structure.hpp"
+#include "data_structure/alive_view.hpp"
+#include "utils/thread_pool.hpp"
+#include "config.hpp"
+
+// Spatial index over all disks of a problem, built once per solve.
+// Phases of the algorithm (BFS in find_levels and per level structures in find_blocking_family) do not build their own
+// data structures, they query this one through views. Views are created in constant time and deleting a disk from a
+// view is a single store, see AliveView.
+template<class T>
+struct SpatialIndex {
+    std::unique_ptr<DataStructure<T>> structure;
+    AliveStamps stamps;
+    // Threads used by parallel steps of the solve, nullptr if Config::threads is 1.
+    // (disk queries on views are read only, so threads can query the structure at the same time)
+    ThreadPool *pool = nullptr;
+
+private:
+    // Pool of this index, if it was not given one.
+    std::unique_ptr<ThreadPool> own_pool;
+
+public:
+    // Disks should have indices set.
+    // Indices of subproblems of a single solve should share one pool (see make_thread_pool), otherwise the index
+    // starts its own threads.
+    SpatialIndex(const std::vector<Disk<T>> &disks, const Config<T> &config, ThreadPool *shared_pool = nullptr)
+            : structure(config.data_structure_constructor()), stamps(disks.size()) {
+        structure->rebuild(std::vector<GeometryObject<T>>(disks.begin(), disks.end()));
+        if (config.threads > 1) {
+            if (shared_pool == nullptr) {
+                own_pool = std::make_unique<ThreadPool>(config.threads);
+                shared_pool = own_pool.get();
+            }
+            pool = shared_pool;
+        }
+    }
+
+    // New view in which all disks are alive.
+    AliveView all_disks() {
+        return AliveView::all_disks(stamps, stamps.reserve(1));
+    }
+
+    // Given number of new empty views.
+    std::vector<AliveView> empty_views(uint32_t count) {
+        uint32_t first = stamps.reserve(count);
+
+        std::vector<AliveView> views;
+        views.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            views.push_back(AliveView::members(stamps, first + i));
+        }
+        return views;
+    }
+};
+
+// Pool for all spatial indices of a solve, nullptr if Config::threads is 1.
+template<class T>
+std::unique_ptr<ThreadPool> make_thread_pool(const Config<T> &config) {
+    if (config.threads <= 1) {
+        return nullptr;
+    }
+    return std::make_unique<ThreadPool>(config.threads);
+}
+
+#endif //BARRIER_RESILIENCE_SPATIAL_INDEX_HPP
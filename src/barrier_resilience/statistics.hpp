@@ -0,0 +1,70 @@
+#ifndef BARRIER_RESILIENCE_STATISTICS_HPP
+#define BARRIER_RESILIENCE_STATISTICS_HPP
+
+#include <vector>
+#include <algorithm>
+
+// Counters collected by the solver, used by experiments to see where the time goes.
+// Collected only if Config::statistics points to an instance.
+struct Statistics {
+    // Number of phases (blocking family computations) performed.
+    int phases = 0;
+    // Total number of paths found in all phases.
+    long long paths = 0;
+    // Number of vertices visited by DFS in the layered residual graph (over all phases).
+    long long explored_vertices = 0;
+    // Number of vertices of level graphs which are not on any shortest path from source to sink, removed by
+    // Config::shortest_path_pruning (over all phases).
+    long long pruned_level_vertices = 0;
+    // Number of odd BFS layers computed top-down (querying unvisited disks with the last layer) and bottom-up (querying
+    // the last layer with unvisited disks), see Config::direction_optimizing_bfs.
+    long long top_down_layers = 0;
+    long long bottom_up_layers = 0;
+
+    // Time (in seconds) spent building view of each level of the layered residual graph (level_build_time[i] for
+    // level i, summed over all phases).
+    std::vector<double> level_build_time;
+
+    // Number of disks given to the solver and number of them removed by Config::prune_dead_ends (disks which are not on
+    // any chain from left to right border).
+    long long input_disks = 0;
+    long long pruned_disks = 0;
+    // Number of paths found by the greedy packing of Config::warm_start (included in paths).
+    long long warm_start_paths = 0;
+    // Time (in seconds) spent in the greedy packing of Config::warm_start.
+    double warm_start_time = 0;
+    // Number of single augmenting path searches which found a path (Config::hybrid_phases, included in paths) and the
+    // last switch threshold (phases finding at most this many paths are followed by single path searches).
+    long long single_path_searches = 0;
+    double single_path_threshold = 0;
+
+    // Fraction of input disks removed by dead end pruning.
+    double pruned_disks_ratio() const {
+        return input_disks > 0 ? static_cast<double>(pruned_disks) / static_cast<double>(input_disks) : 0;
+    }
+
+    // Add counters collected by other (independent) solve, e.g. of a single component.
+    void add(const Statistics &other) {
+        phases += other.phases;
+        paths += other.paths;
+        explored_vertices += other.explored_vertices;
+        pruned_level_vertices += other.pruned_level_vertices;
+        top_down_layers += other.top_down_layers;
+        bottom_up_layers += other.bottom_up_layers;
+        input_disks += other.input_disks;
+        pruned_disks += other.pruned_disks;
+        warm_start_paths += other.warm_start_paths;
+        warm_start_time += other.warm_start_time;
+        single_path_searches += other.single_path_searches;
+        single_path_threshold = std::max(single_path_threshold, other.single_path_threshold);
+
+        if (level_build_time.size() < other.level_build_time.size()) {
+            level_build_time.resize(other.level_build_time.size(), 0);
+        }
+        for (std::size_t i = 0; i < other.level_build_time.size(); i++) {
+            level_build_time[i] += other.level_build_time[i];
+        }
+    }
+};
+
+#endif //BARRIER_RESILIENCE_STATISTICS_HPP
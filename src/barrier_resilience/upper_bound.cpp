@@ -0,0 +1,257 @@
+#include "upper_bound.hpp"
+
+// Number of grid points per disk used by crossing_curve_cut.
+const double cells_per_disk = 16;
+
+template<class T>
+std::vector<int> bfs_layer_cut(
+        const std::vector<Disk<T>> &disks,
+        const T &left_border_x,
+        const T &right_border_x,
+        SpatialIndex<T> &index
+) {
+    const auto left_border = Border<T>{left_border_x, true};
+    const auto right_border = Border<T>{right_border_x, false};
+
+    if (intersects(left_border, right_border)) {
+        // Nothing can be cut
+        return {};
+    }
+
+    auto &ds = *index.structure;
+    auto unvisited = index.all_disks();
+
+    // First layer - disks intersecting the left border
+    std::vector<int> layer;
+    while (true) {
+        auto n = ds.intersecting(left_border, unvisited);
+        if (!n.has_value()) {
+            break;
+        }
+        unvisited.erase(n.value().get_index());
+        layer.push_back(n.value().get_index());
+    }
+
+    std::vector<int> smallest_layer;
+    bool first_layer = true;
+
+    while (!layer.empty()) {
+        if (first_layer || layer.size() < smallest_layer.size()) {
+            smallest_layer = layer;
+            first_layer = false;
+        }
+
+        // Layers after the first one which reaches the right border are not cuts
+        bool reaches_right_border = std::any_of(layer.begin(), layer.end(), [&](int d) {
+            return intersects(disks[d], right_border);
+        });
+        if (reaches_right_border) {
+            return smallest_layer;
+        }
+
+        std::vector<int> next_layer;
+        for (auto d: layer) {
+            while (true) {
+                auto n = ds.intersecting(disks[d], unvisited);
+                if (!n.has_value()) {
+                    break;
+                }
+                unvisited.erase(n.value().get_index());
+                next_layer.push_back(n.value().get_index());
+            }
+        }
+        layer.swap(next_layer);
+    }
+
+    // Right border was not reached, no disk has to be removed
+    return {};
+}
+
+template<class T>
+std::vector<int> crossing_curve_cut(
+        const std::vector<Disk<T>> &disks,
+        const T &left_border_x,
+        const T &right_border_x
+) {
+    if (disks.empty() || intersects(Border<T>{left_border_x, true}, Border<T>{right_border_x, false})) {
+        // Nothing has to be removed
+        return {};
+    }
+
+    // Geometry is computed in doubles (grid points are not integral)
+    const auto n = static_cast<int>(disks.size());
+    const auto left = static_cast<double>(left_border_x);
+    const auto width = static_cast<double>(right_border_x) - left;
+
+    double top = -std::numeric_limits<double>::infinity();
+    double bottom = std::numeric_limits<double>::infinity();
+    double max_radius = 0;
+    for (const auto &disk: disks) {
+        top = std::max(top, static_cast<double>(disk.center.y) + static_cast<double>(disk.radius));
+        bottom = std::min(bottom, static_cast<double>(disk.center.y) - static_cast<double>(disk.radius));
+        max_radius = std::max(max_radius, static_cast<double>(disk.radius));
+    }
+    const double height = top - bottom;
+
+    // Size of grid cells
+    double cell_size = std::max(std::sqrt(width * height / (cells_per_disk * n)), max_radius / 4);
+    if (!(cell_size > 0)) {
+        cell_size = width;
+    }
+
+    // Point (i, j) is the center of cell (i, j). Row 0 is above all disks, last row is below all disks.
+    const int columns = std::max(1, static_cast<int>(std::ceil(width / cell_size)));
+    const int rows = static_cast<int>(std::ceil(height / cell_size)) + 2;
+    const double column_width = width / columns;
+
+    auto point_x = [&](int i) { return left + (i + 0.5) * column_width; };
+    auto point_y = [&](int j) { return top + cell_size / 2 - j * cell_size; };
+    auto point_id = [columns](int i, int j) { return j * columns + i; };
+
+    // Disks overlapping each cell (by bounding box), stored in a single array (cell_start[c]..cell_start[c + 1])
+    auto column_of = [&](double x) {
+        return std::clamp(static_cast<int>(std::floor((x - left) / column_width)), 0, columns - 1);
+    };
+    auto row_of = [&](double y) {
+        return std::clamp(static_cast<int>(std::floor((top + cell_size - y) / cell_size)), 0, rows - 1);
+    };
+    auto for_each_cell = [&](const Disk<T> &disk, auto f) {
+        const auto x = static_cast<double>(disk.center.x);
+        const auto y = static_cast<double>(disk.center.y);
+        const auto r = static_cast<double>(disk.radius);
+        for (int j = row_of(y + r); j <= row_of(y - r); j++) {
+            for (int i = column_of(x - r); i <= column_of(x + r); i++) {
+                f(point_id(i, j));
+            }
+        }
+    };
+
+    std::vector<int> cell_start(columns * rows + 1, 0);
+    for (const auto &disk: disks) {
+        for_each_cell(disk, [&](int c) { cell_start[c + 1]++; });
+    }
+    for (int c = 0; c < columns * rows; c++) {
+        cell_start[c + 1] += cell_start[c];
+    }
+    std::vector<int> cell_disks(cell_start.back());
+    {
+        auto next = cell_start;
+        for (int d = 0; d < n; d++) {
+            for_each_cell(disks[d], [&](int c) { cell_disks[next[c]++] = d; });
+        }
+    }
+
+    // Geometry predicates, with tolerance on the side of paying for a disk
+    auto squared_distance_to_center = [&](int d, double x, double y) {
+        const double dx = x - static_cast<double>(disks[d].center.x);
+        const double dy = y - static_cast<double>(disks[d].center.y);
+        return dx * dx + dy * dy;
+    };
+    auto squared_radius = [&](int d) {
+        return static_cast<double>(disks[d].radius) * static_cast<double>(disks[d].radius);
+    };
+    auto contains = [&](int d, double x, double y) {
+        return squared_distance_to_center(d, x, y) < squared_radius(d) * (1 - 1e-9);
+    };
+    auto touches_segment = [&](int d, double x1, double y1, double x2, double y2) {
+        const double dx = x2 - x1;
+        const double dy = y2 - y1;
+        double t = ((static_cast<double>(disks[d].center.x) - x1) * dx +
+                    (static_cast<double>(disks[d].center.y) - y1) * dy) / (dx * dx + dy * dy);
+        t = std::clamp(t, 0.0, 1.0);
+        return squared_distance_to_center(d, x1 + t * dx, y1 + t * dy) <= squared_radius(d) * (1 + 1e-9);
+    };
+
+    // Call f(d) for disks touching segment between neighboring points p and q (segment lies in the cells of p and q).
+    std::vector<int> last_segment(n, -1);
+    int segment = 0;
+    auto for_each_touching_disk = [&](int p, int q, auto f) {
+        segment++;
+        const double x1 = point_x(p % columns), y1 = point_y(p / columns);
+        const double x2 = point_x(q % columns), y2 = point_y(q / columns);
+        for (int c: {p, q}) {
+            for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+                const int d = cell_disks[k];
+                if (last_segment[d] != segment && touches_segment(d, x1, y1, x2, y2)) {
+                    last_segment[d] = segment;
+                    f(d);
+                }
+            }
+        }
+    };
+
+    // Dijkstra from all points of the first row to any point of the last row
+    std::vector<int> cost(columns * rows, std::numeric_limits<int>::max());
+    std::vector<int> parent(columns * rows, -1);
+    using Entry = std::pair<int, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+    for (int i = 0; i < columns; i++) {
+        cost[point_id(i, 0)] = 0;
+        queue.emplace(0, point_id(i, 0));
+    }
+
+    int end = -1;
+    while (!queue.empty()) {
+        auto [c, p] = queue.top();
+        queue.pop();
+        if (c != cost[p]) {
+            continue;
+        }
+        if (p / columns == rows - 1) {
+            end = p;
+            break;
+        }
+
+        const int i = p % columns;
+        const int j = p / columns;
+        const double x = point_x(i);
+        const double y = point_y(j);
+
+        for (auto [di, dj]: {std::pair{0, 1}, {-1, 0}, {1, 0}, {0, -1}}) {
+            if (i + di < 0 || i + di >= columns || j + dj < 0 || j + dj >= rows) {
+                continue;
+            }
+            const int q = point_id(i + di, j + dj);
+
+            int step_cost = 0;
+            for_each_touching_disk(p, q, [&](int d) {
+                if (!contains(d, x, y)) {
+                    step_cost++;
+                }
+            });
+
+            if (c + step_cost < cost[q]) {
+                cost[q] = c + step_cost;
+                parent[q] = p;
+                queue.emplace(cost[q], q);
+            }
+        }
+    }
+
+    // Disks touched by the curve (each of them counted once, so there are at most cost[end] of them)
+    std::vector<bool> touched(n, false);
+    for (int q = end; parent[q] != -1; q = parent[q]) {
+        for_each_touching_disk(parent[q], q, [&](int d) { touched[d] = true; });
+    }
+
+    std::vector<int> cut;
+    for (int d = 0; d < n; d++) {
+        if (touched[d]) {
+            cut.push_back(d);
+        }
+    }
+    return cut;
+}
+
+// Force compiler to instantiate the template for the types we need
+template std::vector<int> bfs_layer_cut<int>(const std::vector<Disk<int>> &disks,
+        const int &left_border_x, const int &right_border_x, SpatialIndex<int> &index);
+
+template std::vector<int> bfs_layer_cut<double>(const std::vector<Disk<double>> &disks,
+        const double &left_border_x, const double &right_border_x, SpatialIndex<double> &index);
+
+template std::vector<int> crossing_curve_cut<int>(const std::vector<Disk<int>> &disks,
+        const int &left_border_x, const int &right_border_x);
+
+template std::vector<int> crossing_curve_cut<double>(const std::vector<Disk<double>> &disks,
+        const double &left_border_x, const double &right_border_x);
@@ -0,0 +1,45 @@
+#ifndef BARRIER_RESILIENCE_UPPER_BOUND_HPP
+#define BARRIER_RESILIENCE_UPPER_BOUND_HPP
+
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <cmath>
+#include <limits>
+#include "utils/geometry_objects.hpp"
+#include "spatial_index.hpp"
+
+// Cheap cuts (sets of disks whose removal opens a way from top to bottom), their sizes are upper bounds on the barrier
+// resilience.
+
+// Smallest layer of BFS from the left border in the intersection graph of disks (layer i contains disks at distance i
+// from the left border). Every chain from left to right border goes through all layers up to the first one which
+// contains a disk intersecting the right border, so each of them is a cut. Costs a single BFS (same as one phase on the
+// empty flow). Returns disk indices, empty if no disk chain reaches the right border.
+template<class T>
+std::vector<int> bfs_layer_cut(
+        // Disks with indices set
+        const std::vector<Disk<T>> &disks,
+        // Left and right boundary of the available space
+        const T &left_border_x,
+        const T &right_border_x,
+        // Spatial index built from disks
+        SpatialIndex<T> &index
+);
+
+// Disks crossed by a curve from top to bottom (between left and right border) which crosses few disks.
+// Minimum crossing curve is found by Dijkstra on a grid of points in the strip: curve is a polyline between
+// neighboring grid points, step from p to q costs the number of disks which touch segment pq but do not contain p (so
+// every disk touched by the curve is paid for at least once). Disks touched by the found curve are a cut. Grid has
+// about cells_per_disk points per disk (cells are not smaller than a quarter of the largest radius), disks are
+// bucketed to grid cells, so it runs in O(n log n) for disks of similar size and does not need the intersection graph.
+// Returns disk positions in the vector (in increasing order), empty if borders intersect.
+template<class T>
+std::vector<int> crossing_curve_cut(
+        const std::vector<Disk<T>> &disks,
+        // Left and right boundary of the available space
+        const T &left_border_x,
+        const T &right_border_x
+);
+
+#endif //BARRIER_RESILIENCE_UPPER_BOUND_HPP
@@ -0,0 +1,108 @@
+#include "warm_start.hpp"
+
+template<class T>
+std::vector<Path> greedy_path_packing(
+        const std::vector<Disk<T>> &disks,
+        const T &left_border_x,
+        const T &right_border_x,
+        SpatialIndex<T> &index
+) {
+    const auto left_border = Border<T>{left_border_x, true};
+    const auto right_border = Border<T>{right_border_x, false};
+
+    if (intersects(left_border, right_border)) {
+        // Path from source to sink without any disks, nothing to pack
+        return {};
+    }
+
+    // Disks touching the left border, from the lowest one
+    std::vector<int> starts;
+    for (int d = 0; d < static_cast<int>(disks.size()); d++) {
+        if (intersects(disks[d], left_border)) {
+            starts.push_back(d);
+        }
+    }
+    std::stable_sort(starts.begin(), starts.end(), [&disks](int a, int b) {
+        return disks[a].center.y < disks[b].center.y;
+    });
+
+    auto &ds = *index.structure;
+    // Disks which were not visited by any search (neither used nor dead ends)
+    auto unvisited = index.all_disks();
+
+    std::vector<Path> paths;
+    // Current chain of the DFS
+    std::vector<int> chain;
+    // Candidates of all disks of the chain, those of chain[i] start at candidates_begin[i] and are sorted so that the
+    // lowest one is the last. Neighbours of a disk are collected (erased from unvisited) once, when it becomes the end
+    // of the chain, so backtracking does not enumerate them again.
+    std::vector<int> candidates;
+    std::vector<std::size_t> candidates_begin;
+
+    auto extend = [&](int d) {
+        chain.push_back(d);
+        candidates_begin.push_back(candidates.size());
+        while (auto n = ds.intersecting(disks[d], unvisited)) {
+            unvisited.erase(n.value().get_index());
+            candidates.push_back(n.value().get_index());
+        }
+        std::sort(candidates.begin() + static_cast<std::ptrdiff_t>(candidates_begin.back()), candidates.end(),
+                  [&disks](int a, int b) { return disks[a].center.y > disks[b].center.y; });
+    };
+
+    for (auto start: starts) {
+        if (!unvisited.alive(start)) {
+            continue;
+        }
+
+        unvisited.erase(start);
+        extend(start);
+
+        while (!chain.empty()) {
+            if (intersects(disks[chain.back()], right_border)) {
+                // Found a chain, convert it to a path in G'
+                Path path;
+                path.emplace_back(source, TransformedVertex{chain.front(), true});
+                for (std::size_t i = 0; i < chain.size(); i++) {
+                    path.emplace_back(TransformedVertex{chain[i], true}, TransformedVertex{chain[i], false});
+                    if (i + 1 < chain.size()) {
+                        path.emplace_back(TransformedVertex{chain[i], false}, TransformedVertex{chain[i + 1], true});
+                    }
+                }
+                path.emplace_back(TransformedVertex{chain.back(), false}, sink);
+
+                paths.push_back(std::move(path));
+
+                // Candidates which were not tried are free for the following searches
+                for (auto n: candidates) {
+                    unvisited.insert(n);
+                }
+                chain.clear();
+                candidates.clear();
+                candidates_begin.clear();
+                break;
+            }
+
+            if (candidates.size() > candidates_begin.back()) {
+                // Continue with the lowest candidate, so that the chain leaves as much space as possible for the
+                // chains above it.
+                const int lowest = candidates.back();
+                candidates.pop_back();
+                extend(lowest);
+            } else {
+                // Dead end, it stays erased from unvisited
+                chain.pop_back();
+                candidates_begin.pop_back();
+            }
+        }
+    }
+
+    return paths;
+}
+
+// Force compiler to instantiate the template for the types we need
+template std::vector<Path> greedy_path_packing<int>(const std::vector<Disk<int>> &disks,
+        const int &left_border_x, const int &right_border_x, SpatialIndex<int> &index);
+
+template std::vector<Path> greedy_path_packing<double>(const std::vector<Disk<double>> &disks,
+        const double &left_border_x, const double &right_border_x, SpatialIndex<double> &index);
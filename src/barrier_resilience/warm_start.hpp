@@ -0,0 +1,31 @@
+#ifndef BARRIER_RESILIENCE_WARM_START_HPP
+#define BARRIER_RESILIENCE_WARM_START_HPP
+
+#include <vector>
+#include <algorithm>
+#include "utils/geometry_objects.hpp"
+#include "utils/transformed_graph.hpp"
+#include "spatial_index.hpp"
+
+// Greedy packing of vertex disjoint chains of disks from left to right border, used as the initial flow of the
+// solver (phases then only have to find the remaining paths).
+// Chains are searched by DFS from disks touching the left border, starting from the lowest one (by center.y), and
+// the DFS always continues with the lowest candidate, so chains are packed from the bottom up. Candidates of a disk
+// are its unvisited neighbours at the time the DFS reaches it, collected by a single enumeration (a disk is a candidate
+// of at most one disk of the chain), those which were not tried are freed once a chain is found. Disks of dead ends
+// are not visited by later searches: disks on a found chain are used, and the right border can only be reachable from
+// a dead end through candidates of disks earlier on the chain, which are tried from there. Packing is not necessarily
+// maximum.
+// Returned paths are in G' (source -> v_in -> v_out -> ... -> sink), empty if borders intersect.
+template<class T>
+std::vector<Path> greedy_path_packing(
+        // Disks with indices set
+        const std::vector<Disk<T>> &disks,
+        // Left and right boundary of the available space
+        const T &left_border_x,
+        const T &right_border_x,
+        // Spatial index built from disks
+        SpatialIndex<T> &index
+);
+
+#endif //BARRIER_RESILIENCE_WARM_START_HPP
@@ -0,0 +1,211 @@
+#ifndef DATA_STRUCTURE_ALIVE_VIEW_HPP
+#define DATA_STRUCTURE_ALIVE_VIEW_HPP
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+
+// Generation stamps of disks, shared by all views of a single data structure.
+// Every view has its own generation and decides if a disk is alive by comparing the stamp of the disk with its
+// generation. This way
+// - deleting a disk from a view is a single store,
+// - creating new views costs nothing, fresh generations are larger than any stamp, so they do not see old stamps.
+// Stamps are read and written atomically (relaxed), so threads can query and claim disks of a view concurrently.
+class AliveStamps {
+private:
+    std::vector<uint32_t> stamps;
+
+    // First generation which was not handed out yet. Stamp 0 is never a generation.
+    uint32_t next_generation = 1;
+
+    // Revision of the alive sets of all views, see DeadPrefixes. Revisions are unique in the whole process, so dead
+    // prefixes found for views of other stamps are never mistaken for ours.
+    uint64_t revision = new_revision();
+
+    // Was some dead prefix found at the current revision? (otherwise adding disks does not need a new revision)
+    bool prefix_at_revision = false;
+
+    static uint64_t new_revision() {
+        static std::atomic<uint64_t> next_revision = 1;
+        return next_revision.fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    AliveStamps() = default;
+
+    explicit AliveStamps(std::size_t number_of_disks) : stamps(number_of_disks, 0) {}
+
+    // Reserve count consecutive fresh generations and return the first one.
+    uint32_t reserve(uint32_t count) {
+        if (next_generation > std::numeric_limits<uint32_t>::max() - count) {
+            // Ran out of generations (practically never happens), start again with all disks unstamped.
+            std::fill(stamps.begin(), stamps.end(), 0);
+            next_generation = 1;
+            revision = new_revision();
+        }
+        uint32_t first = next_generation;
+        next_generation += count;
+        return first;
+    }
+
+    uint32_t operator[](int disk_index) const {
+        return std::atomic_ref(const_cast<uint32_t &>(stamps[disk_index])).load(std::memory_order_relaxed);
+    }
+
+    void stamp(int disk_index, uint32_t generation) {
+        std::atomic_ref(stamps[disk_index]).store(generation, std::memory_order_relaxed);
+    }
+
+    // Atomically replace expected stamp by generation, returns false if stamp was not expected (anymore).
+    bool compare_and_stamp(int disk_index, uint32_t expected, uint32_t generation) {
+        return std::atomic_ref(stamps[disk_index]).compare_exchange_strong(expected, generation,
+                                                                            std::memory_order_relaxed);
+    }
+
+    std::size_t size() const {
+        return stamps.size();
+    }
+
+    uint64_t current_revision() const {
+        return std::atomic_ref(const_cast<uint64_t &>(revision)).load(std::memory_order_relaxed);
+    }
+
+    // Dead prefix was found at the current revision.
+    void mark_prefix() {
+        std::atomic_ref found(prefix_at_revision);
+        if (!found.load(std::memory_order_relaxed)) {
+            found.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // Disk was added to a view, disks of dead prefixes found until now may be alive again.
+    // Safe to call from multiple threads at once (levels are stamped into views in parallel): exactly one of them
+    // clears the flag and starts a new revision, which is in place once all of them are done. The flag is only written
+    // when it is set, so parallel inserts mostly just read it.
+    void revise() {
+        std::atomic_ref found(prefix_at_revision);
+        if (found.load(std::memory_order_relaxed) && found.exchange(false, std::memory_order_relaxed)) {
+            std::atomic_ref(revision).store(new_revision(), std::memory_order_relaxed);
+        }
+    }
+};
+
+
+// Set of disks of a data structure which are alive for a query.
+// There are two kinds of views:
+// - members view: disk is alive iff its stamp is equal to the generation of the view
+//   (view starts empty, disks are added by stamping them),
+// - complement view: disk is alive iff its stamp is different from the generation of the view
+//   (view starts with all disks, disks are removed by stamping them).
+class AliveView {
+private:
+    AliveStamps *stamps = nullptr;
+    uint32_t generation = 0;
+    bool complement = false;
+
+    friend class DeadPrefixes;
+
+public:
+    // Position of the next candidate for border queries. Border queries scan candidates in the order of the structure
+    // and skip those which were already checked, so each view pays for the scan only once.
+    // (view should be queried with a single border, and disks added back to the view after a border query are not
+    // reported by following border queries)
+    std::size_t border_cursor = 0;
+
+    AliveView() = default;
+
+    AliveView(AliveStamps &stamps, uint32_t generation, bool complement)
+            : stamps(&stamps), generation(generation), complement(complement) {}
+
+    // Empty view with given (fresh) generation.
+    static AliveView members(AliveStamps &stamps, uint32_t generation) {
+        return {stamps, generation, false};
+    }
+
+    // View with all disks, generation should be fresh.
+    static AliveView all_disks(AliveStamps &stamps, uint32_t generation) {
+        return {stamps, generation, true};
+    }
+
+    bool alive(int disk_index) const {
+        return ((*stamps)[disk_index] == generation) != complement;
+    }
+
+    // Add disk to the view.
+    void insert(int disk_index) {
+        stamps->stamp(disk_index, complement ? 0 : generation);
+        stamps->revise();
+    }
+
+    // Remove disk from the view.
+    void erase(int disk_index) {
+        stamps->stamp(disk_index, complement ? generation : 0);
+    }
+
+    // Remove disk from the view if it is alive, safe to call from multiple threads at once.
+    // Returns true for exactly one of the threads which claim the same alive disk.
+    bool claim(int disk_index) {
+        if (!complement) {
+            return stamps->compare_and_stamp(disk_index, generation, 0);
+        }
+        while (true) {
+            uint32_t stamp = (*stamps)[disk_index];
+            if (stamp == generation) {
+                return false;
+            }
+            if (stamps->compare_and_stamp(disk_index, stamp, generation)) {
+                return true;
+            }
+        }
+    }
+};
+
+
+// For every node of a data structure (cell, leaf, subtree, ...) number of its first disks which are known to be dead
+// in a view, view queries skip them (all disks of a node dead means the whole node is skipped).
+// Prefix is stored with the generation of the view and the revision of its stamps when it was found. Disks are usually
+// only removed from views, dead disks then stay dead. Adding a disk to any view starts a new revision, which drops all
+// prefixes (disks may be added while no view is queried, not at the same time).
+// Prefixes are read and written atomically (relaxed), threads querying a view at the same time can share them. The
+// generation and the prefix are a single word, so a prefix is never mixed with the generation of another view, and
+// threads writing different prefixes only lose the longer one.
+class DeadPrefixes {
+private:
+    // Generation of the view in the upper half, length of the prefix in the lower one.
+    std::vector<uint64_t> prefixes;
+    std::vector<uint64_t> revisions;
+
+public:
+    void assign(std::size_t number_of_nodes) {
+        prefixes.assign(number_of_nodes, 0);
+        revisions.assign(number_of_nodes, 0);
+    }
+
+    // Number of first disks of the node known to be dead in the view.
+    uint32_t get(std::size_t node, const AliveView &view) const {
+        uint64_t prefix = std::atomic_ref(const_cast<uint64_t &>(prefixes[node])).load(std::memory_order_relaxed);
+        if (prefix >> 32 != view.generation ||
+            std::atomic_ref(const_cast<uint64_t &>(revisions[node])).load(std::memory_order_relaxed) !=
+            view.stamps->current_revision()) {
+            return 0;
+        }
+        return static_cast<uint32_t>(prefix);
+    }
+
+    // First length disks of the node are dead in the view. Revision should be read before the disks were checked.
+    void set(std::size_t node, const AliveView &view, uint64_t revision, uint32_t length) {
+        std::atomic_ref(prefixes[node]).store(static_cast<uint64_t>(view.generation) << 32 | length,
+                                              std::memory_order_relaxed);
+        std::atomic_ref(revisions[node]).store(revision, std::memory_order_relaxed);
+        view.stamps->mark_prefix();
+    }
+
+    // Revision to pass to set, read at the start of a query.
+    static uint64_t revision(const AliveView &view) {
+        return view.stamps->current_revision();
+    }
+};
+
+#endif //DATA_STRUCTURE_ALIVE_VIEW_HPP
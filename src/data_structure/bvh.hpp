@@ -0,0 +1,344 @@
+#ifndef DATA_STRUCTURE_BVH_HPP
+#define DATA_STRUCTURE_BVH_HPP
+
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <algorithm>
+#include "utils/geometry_objects.hpp"
+#include "data_structure/data_structure.hpp"
+
+
+// Bounding volume hierarchy over bounding boxes of disks, for disks with arbitrary radii.
+// Tree is built top-down in O(n log n): disks of a node are split at the median center along the longer side of the
+// node, until at most leaf_size disks are left. Nodes are stored in a single array in depth-first order (left child
+// directly follows its parent), disks are reordered so that every node covers a contiguous range of them.
+// Every node counts its live (not deleted) disks, traversals skip subtrees without live disks. Within a leaf, live
+// disks come first and deleted ones are swapped behind them.
+// Views can not use the counts (they do not modify the structure), view queries keep dead prefixes of leaves instead
+// (see DeadPrefixes) and skip nodes whose all disks are dead in the view.
+template<class T>
+class BVH : public DataStructure<T> {
+private:
+    static constexpr int leaf_size = 8;
+
+    // Deeper trees are not possible, every split halves the number of disks.
+    static constexpr int max_depth = 64;
+
+    struct Node {
+        // Bounding box of all disks of the node.
+        T min_x, min_y, max_x, max_y;
+
+        // Disks of the node are disks[begin .. end).
+        int begin, end;
+
+        // Index of the right child, 0 for leaves (left child is the next node).
+        int right;
+
+        int live;
+    };
+
+    // Potentially left and right border.
+    std::vector<Border<T>> borders;
+
+    std::vector<Node> nodes;
+    std::vector<Disk<T>> disks;
+
+    // Number of first disks of leaves dead in a view, for inner nodes all or nothing.
+    DeadPrefixes dead_prefixes;
+
+    // First disk which can still intersect the border, for each border query (disks before it were checked by
+    // previous queries, see KDTree). Points at the beginning of a leaf, because deletions reorder disks of the leaf.
+    std::unordered_map<const Border<T>, std::size_t, BorderHash<T>> border_checked_index_cache;
+
+    // Build subtree over disks[begin .. end), low and high bound centers of these disks.
+    int build(int begin, int end, Point<T> low, Point<T> high) {
+        const int index = static_cast<int>(nodes.size());
+        nodes.push_back({0, 0, 0, 0, begin, end, 0, end - begin});
+
+        if (end - begin <= leaf_size) {
+            auto &node = nodes[index];
+            node.min_x = disks[begin].center.x - disks[begin].radius;
+            node.min_y = disks[begin].center.y - disks[begin].radius;
+            node.max_x = disks[begin].center.x + disks[begin].radius;
+            node.max_y = disks[begin].center.y + disks[begin].radius;
+            for (int i = begin + 1; i < end; i++) {
+                const auto &d = disks[i];
+                node.min_x = std::min(node.min_x, d.center.x - d.radius);
+                node.min_y = std::min(node.min_y, d.center.y - d.radius);
+                node.max_x = std::max(node.max_x, d.center.x + d.radius);
+                node.max_y = std::max(node.max_y, d.center.y + d.radius);
+            }
+            return index;
+        }
+
+        // Split at the median, bounds of centers of children follow from the median (no need to scan the disks).
+        const int middle = begin + (end - begin) / 2;
+        Point<T> left_high = high;
+        Point<T> right_low = low;
+        if (high.x - low.x >= high.y - low.y) {
+            std::nth_element(disks.begin() + begin, disks.begin() + middle, disks.begin() + end,
+                             [](const Disk<T> &a, const Disk<T> &b) { return a.center.x < b.center.x; });
+            left_high.x = right_low.x = disks[middle].center.x;
+        } else {
+            std::nth_element(disks.begin() + begin, disks.begin() + middle, disks.begin() + end,
+                             [](const Disk<T> &a, const Disk<T> &b) { return a.center.y < b.center.y; });
+            left_high.y = right_low.y = disks[middle].center.y;
+        }
+
+        build(begin, middle, low, left_high);
+        const int right = build(middle, end, right_low, high);
+
+        // Box of the node is the union of boxes of children.
+        const auto &l = nodes[index + 1];
+        const auto &r = nodes[right];
+        auto &node = nodes[index];
+        node.min_x = std::min(l.min_x, r.min_x);
+        node.min_y = std::min(l.min_y, r.min_y);
+        node.max_x = std::max(l.max_x, r.max_x);
+        node.max_y = std::max(l.max_y, r.max_y);
+        node.right = right;
+        return index;
+    }
+
+    // Can some disk of the node intersect the object?
+    static bool may_intersect(const Node &node, const GeometryObject<T> &object) {
+        return object | match{
+                [&node](const Disk<T> &d) {
+                    // Distance from the center of the disk to the box.
+                    T dx = std::max({node.min_x - d.center.x, d.center.x - node.max_x, T(0)});
+                    T dy = std::max({node.min_y - d.center.y, d.center.y - node.max_y, T(0)});
+                    return dx * dx + dy * dy <= d.radius * d.radius;
+                },
+                [&node](const Border<T> &b) {
+                    return b.left ? node.min_x <= b.x : node.max_x >= b.x;
+                }
+        };
+    }
+
+    // Is the center of box a closer to the point than the center of box b?
+    static bool closer(const Node &a, const Node &b, const Point<T> &p) {
+        // (doubled coordinates of centers, to stay in integers)
+        T ax = a.min_x + a.max_x - 2 * p.x, ay = a.min_y + a.max_y - 2 * p.y;
+        T bx = b.min_x + b.max_x - 2 * p.x, by = b.min_y + b.max_y - 2 * p.y;
+        return ax * ax + ay * ay < bx * bx + by * by;
+    }
+
+    bool dead_in_view(int index, const AliveView &view) const {
+        return dead_prefixes.get(index, view) == static_cast<uint32_t>(nodes[index].end - nodes[index].begin);
+    }
+
+    // Depth-first traversal of nodes which may intersect the object, starting with disk from (disks are visited in
+    // their order). Calls check(i) for disks i of leaves which are live (alive in the view, if there is one) until it
+    // returns true.
+    // Returns index of the disk for which check returned true, or -1.
+    template<class F>
+    int traverse(const GeometryObject<T> &object, std::size_t from, AliveView *view, F check) {
+        if (nodes.empty()) {
+            return -1;
+        }
+
+        const uint64_t revision = view != nullptr ? DeadPrefixes::revision(*view) : 0;
+        const int first = static_cast<int>(std::min(from, disks.size()));
+        int stack[max_depth];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const int index = stack[--top];
+            const auto &node = nodes[index];
+            if (node.end <= first || (view == nullptr && node.live == 0) || !may_intersect(node, object)) {
+                continue;
+            }
+            if (view != nullptr && dead_in_view(index, *view)) {
+                continue;
+            }
+            if (node.right == 0 && view == nullptr) {
+                for (int i = std::max(node.begin, first); i < node.begin + node.live; i++) {
+                    if (check(i)) {
+                        return i;
+                    }
+                }
+                continue;
+            }
+            if (node.right == 0) {
+                // Disks [node.begin, dead) are dead in the view. Stamps of disks which check does not accept are only
+                // read while the prefix can still grow.
+                const int prefix = node.begin + static_cast<int>(dead_prefixes.get(index, *view));
+                int dead = prefix;
+                int found = -1;
+                for (int i = std::max(prefix, first); i < node.end && found < 0; i++) {
+                    const bool accepted = check(i);
+                    if (accepted || dead == i) {
+                        if (view->alive(disks[i].get_index())) {
+                            found = accepted ? i : found;
+                        } else if (dead == i) {
+                            dead++;
+                        }
+                    }
+                }
+                if (dead > prefix) {
+                    dead_prefixes.set(index, *view, revision, static_cast<uint32_t>(dead - node.begin));
+                }
+                if (found >= 0) {
+                    return found;
+                }
+                continue;
+            }
+            if (view != nullptr && dead_in_view(index + 1, *view) && dead_in_view(node.right, *view)) {
+                // Both children are dead in the view, so is the node (checked by later queries first).
+                dead_prefixes.set(index, *view, revision, static_cast<uint32_t>(node.end - node.begin));
+                continue;
+            }
+            // Border queries go over disks in order (left child first), disk queries go to the child with the center
+            // closer to the query first, it is more likely to have an intersecting disk.
+            int near = index + 1;
+            int far = node.right;
+            if (is_disk(object) && closer(nodes[far], nodes[near], std::get<Disk<T>>(object).center)) {
+                std::swap(near, far);
+            }
+            stack[top++] = far;
+            stack[top++] = near;
+        }
+        return -1;
+    }
+
+    // Leaf which contains the disk with given index.
+    int leaf_of(int disk) const {
+        int node = 0;
+        while (nodes[node].right != 0) {
+            node = disk < nodes[nodes[node].right].begin ? node + 1 : nodes[node].right;
+        }
+        return node;
+    }
+
+    // Remove a live disk equal to the given one from the subtree, returns true if it was found.
+    bool erase(int index, const Disk<T> &disk) {
+        auto &node = nodes[index];
+        if (node.live == 0 || !may_intersect(node, static_cast<GeometryObject<T>>(Disk<T>{disk.center, 0}))) {
+            return false;
+        }
+
+        if (node.right == 0) {
+            // Copies of a disk are told apart by index.
+            const int last = node.begin + node.live - 1;
+            for (int i = node.begin; i <= last; i++) {
+                if (disks[i] == disk && disks[i].get_index() == disk.get_index()) {
+                    std::swap(disks[i], disks[last]);
+                    node.live--;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        if (erase(index + 1, disk) || erase(node.right, disk)) {
+            nodes[index].live--;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    void rebuild(const std::vector<GeometryObject<T>> &objects) {
+        borders.clear();
+        disks.clear();
+        nodes.clear();
+        border_checked_index_cache.clear();
+
+        for (const auto &o: objects) {
+            if (is_disk(o)) {
+                disks.push_back(std::get<Disk<T>>(o));
+            } else {
+                borders.push_back(std::get<Border<T>>(o));
+            }
+        }
+
+        if (!disks.empty()) {
+            nodes.reserve(2 * (disks.size() / (leaf_size / 2) + 1));
+            Point<T> low = disks[0].center;
+            Point<T> high = disks[0].center;
+            for (const auto &disk: disks) {
+                low = {std::min(low.x, disk.center.x), std::min(low.y, disk.center.y)};
+                high = {std::max(high.x, disk.center.x), std::max(high.y, disk.center.y)};
+            }
+            build(0, static_cast<int>(disks.size()), low, high);
+        }
+        dead_prefixes.assign(nodes.size());
+    }
+
+    // Given a disk D (not necessarily from the structure), return a disk D' that intersects D (if any).
+    std::optional<GeometryObject<T>> intersecting(const GeometryObject<T> &object) {
+        // Check intersection with borders
+        for (const auto &b: borders) {
+            if (intersects(object, static_cast<GeometryObject<T>>(b))) {
+                return {b};
+            }
+        }
+
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
+
+            std::size_t &cursor = border_checked_index_cache[border];
+            int found = traverse(object, cursor, nullptr, [&](int i) { return intersects(border, disks[i]); });
+            if (found < 0) {
+                cursor = disks.size();
+                return {};
+            }
+            cursor = nodes[leaf_of(found)].begin;
+            return {disks[found]};
+        }
+
+        const auto &disk = std::get<Disk<T>>(object);
+        int found = traverse(object, 0, nullptr, [&](int i) { return intersects(disk, disks[i]); });
+        if (found < 0) {
+            return {};
+        }
+        return {disks[found]};
+    }
+
+    // Given a disk or a border, return a disk alive in the view that intersects it (if any).
+    std::optional<Disk<T>> intersecting(const GeometryObject<T> &object, AliveView &view) {
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
+
+            // Same as above, but the position is kept in the view (disks of a view are never reordered).
+            int found = traverse(object, view.border_cursor, &view, [&](int i) {
+                return intersects(border, disks[i]);
+            });
+            if (found < 0) {
+                view.border_cursor = disks.size();
+                return {};
+            }
+            view.border_cursor = found;
+            return {disks[found]};
+        }
+
+        const auto &disk = std::get<Disk<T>>(object);
+        int found = traverse(object, 0, &view, [&](int i) { return intersects(disk, disks[i]); });
+        if (found < 0) {
+            return {};
+        }
+        return {disks[found]};
+    }
+
+    // Delete object (if it exists) from the structure.
+    void delete_object(const GeometryObject<T> &o) {
+        if (!is_disk(o)) {
+            auto border = std::get<Border<T>>(o);
+            // Delete border from the list of borders.
+            for (auto it = borders.begin(); it != borders.end(); ++it) {
+                if (*it == border) {
+                    borders.erase(it);
+                    return;
+                }
+            }
+            return;
+        }
+
+        if (!nodes.empty()) {
+            erase(0, std::get<Disk<T>>(o));
+        }
+    }
+};
+
+#endif //DATA_STRUCTURE_BVH_HPP
@@ -0,0 +1,257 @@
+#ifndef DATA_STRUCTURE_CGAL_KDTREE_HPP
+#define DATA_STRUCTURE_CGAL_KDTREE_HPP
+
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <CGAL/Simple_cartesian.h>
+#include <CGAL/Orthogonal_k_neighbor_search.h>
+#include <CGAL/Orthogonal_incremental_neighbor_search.h>
+#include <CGAL/Search_traits_adapter.h>
+#include <CGAL/Search_traits_2.h>
+#include "utils/geometry_objects.hpp"
+#include "utils/flat_hash_set.hpp"
+#include "data_structure/data_structure.hpp"
+
+template<class T>
+using Cartesian = CGAL::Simple_cartesian<T>;
+
+template<class T>
+using Point_2 = typename Cartesian<T>::Point_2;
+
+template<class T>
+using SearchTraits = CGAL::Search_traits_2<Cartesian<T>>;
+
+// Add disk index to 2D point in a tree.
+template<class T>
+using Point_and_index = std::tuple<Point_2<T>, int>;
+
+// Modified search traits that allows us to search on modified points.
+template<class T>
+using Traits = CGAL::Search_traits_adapter<
+        Point_and_index<T>,
+        CGAL::Nth_of_tuple_property_map<0, Point_and_index<T>>,
+        SearchTraits<T>>;
+
+// Possible strategies:
+// - Orthogonal_k_neighbor_search
+// - Orthogonal_incremental_neighbor_search
+// - K_neighbor_search
+// - Incremental_neighbor_search
+// We use the 2nd one because:
+// - it's incremental (allowing us to add and remove points).
+// - it's orthogonal (great for Minkowski metric vs K_neighbor_search which is for Manhattan metric).
+// https://doc.cgal.org/latest/Spatial_searching/index.html
+template<class T>
+using NN = CGAL::Orthogonal_k_neighbor_search<Traits<T>>;
+
+// Incremental search reports points by increasing distance, used for queries on views where closest points might not
+// be alive.
+template<class T>
+using IncrementalNN = CGAL::Orthogonal_incremental_neighbor_search<Traits<T>>;
+
+
+// kd-tree from CGAL, kept as a reference for KDTree (in-house implementation, see kdtree.hpp).
+template<class T>
+class CGALKDTree : public DataStructure<T> {
+private:
+    typename NN<T>::Tree tree;
+
+    // Potentially left and right border.
+    std::vector<Border<T>> borders;
+
+    // Vector of all disks, used to check intersection with borders.
+    std::vector<Disk<T>> disks;
+
+    // Save last checked index for each border query.
+    // (there will be a lot of queries for the same border,
+    // actually we expect that there will be only 2 borders).
+    // Using cache, we amortize the cost of checking for intersection with borders
+    // from O(n^2) to O(n).
+    // If query call is repeated, simply start checking from the last checked index.
+    // If disk is still there, we can just return it, otherwise we can continue checking.
+    std::unordered_map<const Border<T>, int, BorderHash<T>> border_checked_index_cache;
+
+    // Indices of deleted disks (as unsigned keys, so disks without an index (-1) do not collide with the empty slot).
+    FlatHashSet deleted_disks;
+
+    // Radius of all disks in the structure should be the same.
+    T radius = 0;
+
+    Point_and_index<T> disk_to_point(const Disk<T> &disk) const {
+        return std::make_tuple(
+                Point_2<T>(disk.center.x, disk.center.y),
+                disk.get_index()
+        );
+    }
+
+    Disk<T> point_to_disk(const Point_and_index<T> &point) const {
+        // Unpack point and index.
+        const Point_2<T> p = std::get<0>(point);
+        const int index = std::get<1>(point);
+
+        auto disk = Disk<T>{{p.x(), p.y()}, radius};
+        disk.unsafe_set_index(index);
+        return disk;
+    }
+
+public:
+    void rebuild(const std::vector<GeometryObject<T>> &objects) {
+        tree.clear();
+        disks = {};
+        borders = {};
+        border_checked_index_cache.clear();
+        deleted_disks.clear();
+        radius = 0;
+
+        // Filter objects and add disks to the tree.
+        for (const auto &o: objects) {
+            if (is_disk(o)) {
+                auto disk = std::get<Disk<T>>(o);
+
+                // Insert into tree
+                tree.insert(disk_to_point(disk));
+                disks.push_back(disk);
+
+                // Check if radius is the same for all disks.
+                if (radius == 0) {
+                    radius = disk.radius;
+                } else {
+                    assert("Radius of all disk should be the same" && radius == disk.radius);
+                }
+            } else {
+                // This is a border.
+                auto border = std::get<Border<T>>(o);
+                borders.push_back(border);
+            }
+        }
+
+        tree.build();
+    }
+
+    // Given a disk D (not necessarily from the structure), return a disk D' that intersects D (if any).
+    std::optional<GeometryObject<T>> intersecting(const GeometryObject<T> &object) {
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
+
+            // Check intersection with borders
+            for (const auto &b: borders) {
+                if (intersects(border, b)) {
+                    return {b};
+                }
+            }
+
+            // Check intersection with disks.
+            // This is O(n) operation, but it's not a problem since it will be cached and amortized.
+
+            // Get last checked index for this border.
+            int last_checked_index = border_checked_index_cache[border];
+            if (last_checked_index >= disks.size()) {
+                // Checked all
+                return {};
+            }
+
+            for (int i = last_checked_index; i < disks.size(); i++) {
+                auto disk = disks[i];
+                // Check only not deleted disks.
+                if (!deleted_disks.contains(static_cast<uint32_t>(disk.get_index())) && intersects(border, disk)) {
+                    // Update last checked index.
+                    border_checked_index_cache[border] = i;
+                    return {disk};
+                }
+            }
+
+            // Update last checked index.
+            border_checked_index_cache[border] = disks.size();
+
+            return {};
+        }
+
+        // Check intersection with borders
+        for (const auto &border: borders) {
+            if (intersects(object, static_cast<GeometryObject<T>>(border))) {
+                return {border};
+            }
+        }
+
+        auto disk = std::get<Disk<T>>(object);
+
+        // Query the tree for nearest neighbor.
+        NN<T> nn(tree, std::get<0>(disk_to_point(disk)));
+
+        auto it = nn.begin();
+        if (it != nn.end()) {
+            // Found a disk that intersects with the query disk.
+            auto point = it->first;
+            auto out_disk = point_to_disk(point);
+
+            // We got the closest disk, but it might not intersect with the query disk.
+            if (intersects(object, static_cast<GeometryObject<T>>(out_disk))) {
+                return {out_disk};
+            }
+        }
+
+        return {};
+    }
+
+    // Given a disk or a border, return a disk alive in the view that intersects it (if any).
+    std::optional<Disk<T>> intersecting(const GeometryObject<T> &object, AliveView &view) {
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
+
+            // Same as above, but the last checked index is kept in the view.
+            for (std::size_t i = view.border_cursor; i < disks.size(); i++) {
+                if (view.alive(disks[i].get_index()) && intersects(border, disks[i])) {
+                    view.border_cursor = i;
+                    return {disks[i]};
+                }
+            }
+            view.border_cursor = disks.size();
+
+            return {};
+        }
+
+        // Go over points by increasing distance from the center of the query disk.
+        // All disks have the same radius, so once a disk does not intersect the query disk, none of the following do.
+        // There are no dead prefixes here, every query starts a new search and walks over all dead neighbours before
+        // the first alive one, so enumerating the neighbours of a disk costs O(deg^2) (O(n^2) when all disks are on the
+        // same point). That is fine for a reference (Config::with_cgal_kdtree), solvers use KDTree or Grid.
+        IncrementalNN<T> nn(tree, std::get<0>(disk_to_point(std::get<Disk<T>>(object))));
+
+        for (auto it = nn.begin(); it != nn.end(); ++it) {
+            auto out_disk = point_to_disk(it->first);
+
+            if (!intersects(object, static_cast<GeometryObject<T>>(out_disk))) {
+                break;
+            }
+            if (view.alive(out_disk.get_index())) {
+                return {out_disk};
+            }
+        }
+
+        return {};
+    }
+
+    // Delete object (if it exists) from the structure.
+    void delete_object(const GeometryObject<T> &o) {
+        if (!is_disk(o)) {
+            auto border = std::get<Border<T>>(o);
+            // Delete border from the list of borders.
+            for (auto it = borders.begin(); it != borders.end(); ++it) {
+                if (*it == border) {
+                    borders.erase(it);
+                    return;
+                }
+            }
+            return;
+        }
+
+        auto disk = std::get<Disk<T>>(o);
+
+        // Remove point representing the disk from the tree.
+        tree.remove(disk_to_point(disk));
+        deleted_disks.insert(static_cast<uint32_t>(disk.get_index()));
+    }
+};
+
+#endif //DATA_STRUCTURE_CGAL_KDTREE_HPP
@@ -4,21 +4,33 @@
 #include <vector>
 #include <optional>
 #include "utils/geometry_objects.hpp"
+#include "alive_view.hpp"
 
 // Data structure from article, should have following operations:
 // - creation from vector of disks
 // - given a disk D (not necessarily from the structure), return a disk D' that intersects D (if any)
 // - delete disk D (if it exists) from the structure
+//
+// Structure can also be built once and queried through views (see AliveView). Views select which disks of the
+// structure are alive, deleting a disk from a view does not modify the structure, so many views (one per phase and
+// level of the algorithm) can share a single structure.
 
 template<class T>
 class DataStructure {
 public:
+    virtual ~DataStructure() = default;
+
     // Reconstruct data structure from vector of disks.
     virtual void rebuild(const std::vector<GeometryObject<T>> &objects_) = 0;
 
     // Given a disk D (not necessarily from the structure), return structure that intersects D (if any).
     virtual std::optional<GeometryObject<T>> intersecting(const GeometryObject<T> &object) = 0;
 
+    // Given a disk or a border, return a disk alive in the view that intersects it (if any).
+    // Only disks are considered (borders in the structure are ignored) and objects removed by delete_object should not
+    // be queried this way. Disks need to have indices set, stamps of the view are indexed by disk indices.
+    virtual std::optional<Disk<T>> intersecting(const GeometryObject<T> &object, AliveView &view) = 0;
+
     // Delete object (if it exists) from the structure.
     virtual void delete_object(const GeometryObject<T> &o) = 0;
 };
@@ -0,0 +1,296 @@
+#ifndef DATA_STRUCTURE_GRID_HPP
+#define DATA_STRUCTURE_GRID_HPP
+
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include "utils/geometry_objects.hpp"
+#include "data_structure/data_structure.hpp"
+
+
+// Uniform grid of square cells, meant for disks with the same (or similar) radius.
+// Cells have size (at least) 2r for the largest radius r, so a disk of radius r can only intersect disks with centers
+// in the 3x3 cells around the cell of its center. Smaller disks are correct too, but cells sized by the largest one
+// hold more disks (see HierarchicalGrid for mixed radii). Cells are stored in flat arrays (CSR): disks of cell c are
+// cell_disks[cell_start[c] .. cell_start[c + 1]), cells are ordered column by column, so cells which can intersect
+// a border form a contiguous range.
+// Deleted disks are swapped to the end of their cell, first cell_live[c] disks of a cell are the ones not deleted.
+// Views can not reorder cells (the structure is shared by all of them), instead view queries remember how many first
+// disks of a cell are dead in the view (see DeadPrefixes) and start scanning the cell after them.
+template<class T>
+class Grid : public DataStructure<T> {
+private:
+    // Potentially left and right border.
+    std::vector<Border<T>> borders;
+
+    // Largest radius of disks in the structure.
+    T radius = 0;
+
+    // Size of a cell and the corner of the first cell.
+    T cell_size = 1;
+    Point<T> origin = {0, 0};
+    long long columns = 0;
+    long long rows = 0;
+
+    std::vector<int> cell_start;
+    std::vector<int> cell_live;
+    std::vector<Disk<T>> cell_disks;
+
+    // First disks of cells dead in a view.
+    DeadPrefixes dead_prefixes;
+
+    // First cell which can still contain a disk intersecting the border, for each border query (cells before it have
+    // no intersecting disk left, see KDTree for the same cache over disks).
+    std::unordered_map<const Border<T>, std::size_t, BorderHash<T>> border_cell_cache;
+
+    // Range of cells [first_column, last_column] x [first_row, last_row], empty if first > last.
+    struct CellRange {
+        long long first_column, last_column, first_row, last_row;
+    };
+
+    // Coordinate of the cell containing value along one axis (not clamped to the grid).
+    long long cell_coordinate(T value, T origin_value) const {
+        return static_cast<long long>(std::floor(
+                (static_cast<double>(value) - static_cast<double>(origin_value)) / static_cast<double>(cell_size)));
+    }
+
+    long long cell_index(long long column, long long row) const {
+        return column * rows + row;
+    }
+
+    // Cells which can contain the center of a disk (of radius r) intersecting the given disk.
+    CellRange cells_around(const Disk<T> &disk) const {
+        const T reach = disk.radius + radius;
+        return {
+                std::max(0LL, cell_coordinate(disk.center.x - reach, origin.x)),
+                std::min(columns - 1, cell_coordinate(disk.center.x + reach, origin.x)),
+                std::max(0LL, cell_coordinate(disk.center.y - reach, origin.y)),
+                std::min(rows - 1, cell_coordinate(disk.center.y + reach, origin.y)),
+        };
+    }
+
+    // Cells [first, last) which can contain the center of a disk intersecting the border.
+    std::pair<std::size_t, std::size_t> cells_of_border(const Border<T> &border) const {
+        long long first_column = 0;
+        long long last_column = columns - 1;
+        if (border.left) {
+            last_column = std::min(last_column, cell_coordinate(border.x + radius, origin.x));
+        } else {
+            first_column = std::max(first_column, cell_coordinate(border.x - radius, origin.x));
+        }
+        if (first_column > last_column) {
+            return {0, 0};
+        }
+        return {cell_index(first_column, 0), cell_index(last_column + 1, 0)};
+    }
+
+public:
+    // Number of cells, border cursors of views are cell positions in [0, number_of_cells()].
+    std::size_t number_of_cells() const {
+        return static_cast<std::size_t>(columns * rows);
+    }
+
+    void rebuild(const std::vector<GeometryObject<T>> &objects) {
+        borders = {};
+        cell_disks = {};
+        border_cell_cache.clear();
+        radius = 0;
+
+        std::vector<Disk<T>> disks;
+        for (const auto &o: objects) {
+            if (is_disk(o)) {
+                auto disk = std::get<Disk<T>>(o);
+                disks.push_back(disk);
+                radius = std::max(radius, disk.radius);
+            } else {
+                borders.push_back(std::get<Border<T>>(o));
+            }
+        }
+
+        if (disks.empty()) {
+            columns = rows = 0;
+            cell_start = {0};
+            cell_live = {};
+            return;
+        }
+
+        // Bounding box of centers.
+        origin = disks[0].center;
+        Point<T> corner = disks[0].center;
+        for (const auto &disk: disks) {
+            origin = {std::min(origin.x, disk.center.x), std::min(origin.y, disk.center.y)};
+            corner = {std::max(corner.x, disk.center.x), std::max(corner.y, disk.center.y)};
+        }
+
+        // Cells of size 2r, unless disks are so sparse that the grid would have many more cells than disks
+        // (larger cells keep queries at 3x3 cells, they just contain more disks).
+        cell_size = radius > 0 ? 2 * radius : 1;
+        while (true) {
+            columns = cell_coordinate(corner.x, origin.x) + 1;
+            rows = cell_coordinate(corner.y, origin.y) + 1;
+            if (static_cast<double>(columns) * static_cast<double>(rows) <= 2.0 * disks.size() + 16) {
+                break;
+            }
+            cell_size *= 2;
+        }
+
+        // Counting sort of disks by cells.
+        const auto number_of_cells = static_cast<std::size_t>(columns * rows);
+        std::vector<long long> cell_of_disk(disks.size());
+        cell_start.assign(number_of_cells + 1, 0);
+        for (std::size_t i = 0; i < disks.size(); i++) {
+            cell_of_disk[i] = cell_index(cell_coordinate(disks[i].center.x, origin.x),
+                                         cell_coordinate(disks[i].center.y, origin.y));
+            cell_start[cell_of_disk[i] + 1]++;
+        }
+        for (std::size_t c = 0; c < number_of_cells; c++) {
+            cell_start[c + 1] += cell_start[c];
+        }
+
+        cell_live.assign(number_of_cells, 0);
+        dead_prefixes.assign(number_of_cells);
+        cell_disks.assign(disks.size(), disks[0]);
+        for (std::size_t i = 0; i < disks.size(); i++) {
+            const auto c = cell_of_disk[i];
+            cell_disks[cell_start[c] + cell_live[c]++] = disks[i];
+        }
+    }
+
+    // Given a disk D (not necessarily from the structure), return a disk D' that intersects D (if any).
+    std::optional<GeometryObject<T>> intersecting(const GeometryObject<T> &object) {
+        // Check intersection with borders
+        for (const auto &b: borders) {
+            if (intersects(object, static_cast<GeometryObject<T>>(b))) {
+                return {b};
+            }
+        }
+
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
+            auto [first, last] = cells_of_border(border);
+
+            // Cells before the cached one had no intersecting disk at the time of the previous query, and disks are
+            // only deleted since then. Current cell is scanned again from its start, since deletions reorder it.
+            std::size_t &cursor = border_cell_cache[border];
+            for (std::size_t c = std::max(cursor, first); c < last; c++) {
+                for (int i = cell_start[c]; i < cell_start[c] + cell_live[c]; i++) {
+                    if (intersects(border, cell_disks[i])) {
+                        cursor = c;
+                        return {cell_disks[i]};
+                    }
+                }
+            }
+            cursor = last;
+
+            return {};
+        }
+
+        const auto &disk = std::get<Disk<T>>(object);
+        const auto range = cells_around(disk);
+        for (long long column = range.first_column; column <= range.last_column; column++) {
+            for (long long row = range.first_row; row <= range.last_row; row++) {
+                const auto c = cell_index(column, row);
+                for (int i = cell_start[c]; i < cell_start[c] + cell_live[c]; i++) {
+                    if (intersects(disk, cell_disks[i])) {
+                        return {cell_disks[i]};
+                    }
+                }
+            }
+        }
+
+        return {};
+    }
+
+    // Given a disk or a border, return a disk alive in the view that intersects it (if any).
+    std::optional<Disk<T>> intersecting(const GeometryObject<T> &object, AliveView &view) {
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
+            auto [first, last] = cells_of_border(border);
+
+            // Same as above, but the cell cursor is kept in the view.
+            for (std::size_t c = std::max(view.border_cursor, first); c < last; c++) {
+                for (int i = cell_start[c]; i < cell_start[c + 1]; i++) {
+                    if (intersects(border, cell_disks[i]) && view.alive(cell_disks[i].get_index())) {
+                        view.border_cursor = c;
+                        return {cell_disks[i]};
+                    }
+                }
+            }
+            view.border_cursor = std::max(view.border_cursor, last);
+
+            return {};
+        }
+
+        const auto &disk = std::get<Disk<T>>(object);
+        const auto range = cells_around(disk);
+        const auto revision = DeadPrefixes::revision(view);
+        for (long long column = range.first_column; column <= range.last_column; column++) {
+            for (long long row = range.first_row; row <= range.last_row; row++) {
+                const auto c = cell_index(column, row);
+                const int first = cell_start[c] + static_cast<int>(dead_prefixes.get(c, view));
+
+                // Disks [cell_start[c], dead) are dead in the view. Stamps of disks which do not intersect the query
+                // are only read while the prefix can still grow.
+                int dead = first;
+                std::optional<Disk<T>> found;
+                for (int i = first; i < cell_start[c + 1] && !found; i++) {
+                    // Intersection test first, it only reads the cell, stamps of the view are scattered in memory.
+                    if (intersects(disk, cell_disks[i])) {
+                        if (view.alive(cell_disks[i].get_index())) {
+                            found = cell_disks[i];
+                        } else if (dead == i) {
+                            dead++;
+                        }
+                    } else if (dead == i && !view.alive(cell_disks[i].get_index())) {
+                        dead++;
+                    }
+                }
+                if (dead > first) {
+                    dead_prefixes.set(c, view, revision, static_cast<uint32_t>(dead - cell_start[c]));
+                }
+                if (found) {
+                    return found;
+                }
+            }
+        }
+
+        return {};
+    }
+
+    // Delete object (if it exists) from the structure.
+    void delete_object(const GeometryObject<T> &o) {
+        if (!is_disk(o)) {
+            auto border = std::get<Border<T>>(o);
+            // Delete border from the list of borders.
+            for (auto it = borders.begin(); it != borders.end(); ++it) {
+                if (*it == border) {
+                    borders.erase(it);
+                    return;
+                }
+            }
+            return;
+        }
+
+        const auto &disk = std::get<Disk<T>>(o);
+        const long long column = cell_coordinate(disk.center.x, origin.x);
+        const long long row = cell_coordinate(disk.center.y, origin.y);
+        if (column < 0 || column >= columns || row < 0 || row >= rows) {
+            return;
+        }
+
+        // Swap the disk with the last live disk of its cell (copies of a disk are told apart by index).
+        const auto c = cell_index(column, row);
+        const int last = cell_start[c] + cell_live[c] - 1;
+        for (int i = cell_start[c]; i <= last; i++) {
+            if (cell_disks[i] == disk && cell_disks[i].get_index() == disk.get_index()) {
+                std::swap(cell_disks[i], cell_disks[last]);
+                cell_live[c]--;
+                return;
+            }
+        }
+    }
+};
+
+#endif //DATA_STRUCTURE_GRID_HPP
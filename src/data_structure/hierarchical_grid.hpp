@@ -0,0 +1,149 @@
+#ifndef DATA_STRUCTURE_HIERARCHICAL_GRID_HPP
+#define DATA_STRUCTURE_HIERARCHICAL_GRID_HPP
+
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <cmath>
+#include "utils/geometry_objects.hpp"
+#include "data_structure/data_structure.hpp"
+#include "data_structure/grid.hpp"
+
+
+// Grids for disks with mixed radii, one level per power-of-two radius class.
+// Level k holds disks with radius in [2^k * s, 2^(k + 1) * s) for the smallest positive radius s, so radii in a level
+// differ at most 2 times and its grid (with cells sized by the largest radius of the level) stays as efficient as for
+// equal radii. Queries visit the cells which can hold an intersecting disk in every level, deletions go only to the
+// level of the disk.
+template<class T>
+class HierarchicalGrid : public DataStructure<T> {
+private:
+    // Potentially left and right border.
+    std::vector<Border<T>> borders;
+
+    // Smallest positive radius, levels are relative to it.
+    T smallest_radius = 0;
+
+    std::vector<Grid<T>> levels;
+
+    // First cell of every level in a single numbering of cells of all levels (plus total number of cells at the end),
+    // border cursors of views are positions in this numbering.
+    std::vector<std::size_t> level_offset;
+
+    // Level of a disk with given radius (disks smaller than the smallest radius go to the first level).
+    std::size_t level_of(T radius) const {
+        if (smallest_radius <= 0 || radius <= smallest_radius) {
+            return 0;
+        }
+        return static_cast<std::size_t>(std::ilogb(static_cast<double>(radius) / static_cast<double>(smallest_radius)));
+    }
+
+public:
+    void rebuild(const std::vector<GeometryObject<T>> &objects) {
+        borders = {};
+        smallest_radius = 0;
+
+        for (const auto &o: objects) {
+            if (is_disk(o)) {
+                const T radius = std::get<Disk<T>>(o).radius;
+                if (radius > 0 && (smallest_radius == 0 || radius < smallest_radius)) {
+                    smallest_radius = radius;
+                }
+            } else {
+                borders.push_back(std::get<Border<T>>(o));
+            }
+        }
+
+        // Split disks into levels, borders are kept here.
+        std::vector<std::vector<GeometryObject<T>>> level_objects;
+        for (const auto &o: objects) {
+            if (is_disk(o)) {
+                const auto level = level_of(std::get<Disk<T>>(o).radius);
+                if (level >= level_objects.size()) {
+                    level_objects.resize(level + 1);
+                }
+                level_objects[level].push_back(o);
+            }
+        }
+
+        levels.resize(level_objects.size());
+        level_offset.assign(level_objects.size() + 1, 0);
+        for (std::size_t k = 0; k < level_objects.size(); k++) {
+            levels[k].rebuild(level_objects[k]);
+            level_offset[k + 1] = level_offset[k] + levels[k].number_of_cells();
+        }
+    }
+
+    // Given a disk D (not necessarily from the structure), return a disk D' that intersects D (if any).
+    std::optional<GeometryObject<T>> intersecting(const GeometryObject<T> &object) {
+        // Check intersection with borders
+        for (const auto &b: borders) {
+            if (intersects(object, static_cast<GeometryObject<T>>(b))) {
+                return {b};
+            }
+        }
+
+        // Levels do not have borders, so they report only disks.
+        // (every level keeps its own border cursors)
+        // Larger disks are more likely to intersect the query and their levels have fewer cells, so they go first.
+        for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+            if (auto found = level->intersecting(object)) {
+                return found;
+            }
+        }
+
+        return {};
+    }
+
+    // Given a disk or a border, return a disk alive in the view that intersects it (if any).
+    std::optional<Disk<T>> intersecting(const GeometryObject<T> &object, AliveView &view) {
+        if (!is_disk(object)) {
+            // Levels are scanned one after another, cursor of the view is translated to the cursor of the level.
+            std::size_t cursor = view.border_cursor;
+            for (std::size_t k = 0; k < levels.size(); k++) {
+                if (cursor >= level_offset[k + 1]) {
+                    continue;
+                }
+                view.border_cursor = std::max(cursor, level_offset[k]) - level_offset[k];
+                if (auto found = levels[k].intersecting(object, view)) {
+                    view.border_cursor += level_offset[k];
+                    return found;
+                }
+                cursor = level_offset[k + 1];
+            }
+            view.border_cursor = std::max(cursor, level_offset.back());
+
+            return {};
+        }
+
+        for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+            if (auto found = level->intersecting(object, view)) {
+                return found;
+            }
+        }
+
+        return {};
+    }
+
+    // Delete object (if it exists) from the structure.
+    void delete_object(const GeometryObject<T> &o) {
+        if (!is_disk(o)) {
+            auto border = std::get<Border<T>>(o);
+            // Delete border from the list of borders.
+            for (auto it = borders.begin(); it != borders.end(); ++it) {
+                if (*it == border) {
+                    borders.erase(it);
+                    return;
+                }
+            }
+            return;
+        }
+
+        const auto level = level_of(std::get<Disk<T>>(o).radius);
+        if (level < levels.size()) {
+            levels[level].delete_object(o);
+        }
+    }
+};
+
+#endif //DATA_STRUCTURE_HIERARCHICAL_GRID_HPP
@@ -4,182 +4,253 @@
 #include <vector>
 #include <optional>
 #include <unordered_map>
-#include <CGAL/Simple_cartesian.h>
-#include <CGAL/Orthogonal_k_neighbor_search.h>
-#include <CGAL/Search_traits_adapter.h>
-#include <CGAL/Search_traits_2.h>
+#include <algorithm>
+#include <cstdint>
 #include "utils/geometry_objects.hpp"
 #include "data_structure/data_structure.hpp"
 
-template<class T>
-using Cartesian = CGAL::Simple_cartesian<T>;
 
+// kd-tree over centers of disks, stored implicitly in a single array (CGALKDTree in cgal_kdtree.hpp is the same
+// structure from CGAL, kept as a reference, see Config::with_cgal_kdtree).
+// Disks are reordered so that every subtree is a contiguous range [begin, end) of the array, its root is the median
+// at position (begin + end) / 2 and the subtrees of the root are the ranges before and after it. Split axis of a node
+// is the wider side of the bounding box of centers in its range.
+// Disk D(p, q) intersects a disk of radius r iff the center of the disk is at most q + r away from p, so queries are
+// searches for centers within distance q + r, with the largest radius r in the structure (disks are meant to have the
+// same radius, smaller ones only make the search less tight).
+// Deleted disks are marked in a bitset and every node counts live disks in its subtree, so subtrees without live disks
+// are skipped. Queries only recurse down the tree, nothing is allocated.
+// Views do not modify the structure, view queries mark subtrees whose all disks are dead in the view instead (see
+// DeadPrefixes, a prefix of a subtree is either empty or the whole subtree). A subtree is marked once a query searched
+// both of its children and found them marked, so regions the queries rarely reach stay unmarked.
 template<class T>
-using Point_2 = typename Cartesian<T>::Point_2;
+class KDTree : public DataStructure<T> {
+private:
+    // Potentially left and right border.
+    std::vector<Border<T>> borders;
 
-template<class T>
-using SearchTraits = CGAL::Search_traits_2<Cartesian<T>>;
+    // Nodes of the tree, in the implicit layout.
+    std::vector<Disk<T>> disks;
 
-// Add disk index to 2D point in a tree.
-template<class T>
-using Point_and_index = std::tuple<Point_2<T>, int>;
+    // Split axis of the node at each position (0 for x, 1 for y).
+    std::vector<uint8_t> split_axis;
 
-// Modified search traits that allows us to search on modified points.
-template<class T>
-using Traits = CGAL::Search_traits_adapter<
-        Point_and_index<T>,
-        CGAL::Nth_of_tuple_property_map<0, Point_and_index<T>>,
-        SearchTraits<T>>;
-
-// Possible strategies:
-// - Orthogonal_k_neighbor_search
-// - Orthogonal_incremental_neighbor_search
-// - K_neighbor_search
-// - Incremental_neighbor_search
-// We use the 2nd one because:
-// - it's incremental (allowing us to add and remove points).
-// - it's orthogonal (great for Minkowski metric vs K_neighbor_search which is for Manhattan metric).
-// https://doc.cgal.org/latest/Spatial_searching/index.html
-template<class T>
-using NN = CGAL::Orthogonal_k_neighbor_search<Traits<T>>;
+    // Number of live disks in the subtree of the node at each position.
+    std::vector<int> subtree_live;
 
+    // Bit i is set if disk at position i was deleted.
+    std::vector<uint64_t> deleted;
 
-template<class T>
-class KDTree : public DataStructure<T> {
-private:
-    typename NN<T>::Tree tree;
+    // Subtrees dead in a view, kept at the position of their root.
+    DeadPrefixes dead_subtrees;
 
-    // Potentially left and right border.
-    std::vector<Border<T>> borders;
+    // Largest radius of disks in the structure.
+    T radius = 0;
 
-    // Vector of all disks, used to check intersection with borders.
-    std::vector<Disk<T>> disks;
+    // Save last checked position for each border query (same as in CGALKDTree, we expect only 2 borders).
+    // Disks are never reordered after the build, so the position only moves forward.
+    std::unordered_map<const Border<T>, std::size_t, BorderHash<T>> border_checked_index_cache;
+
+    bool is_deleted(int i) const {
+        return (deleted[i >> 6] >> (i & 63)) & 1;
+    }
 
-    // Save last checked index for each border query.
-    // (there will be a lot of queries for the same border,
-    // actually we expect that there will be only 2 borders).
-    // Using cache, we amortize the cost of checking for intersection with borders
-    // from O(n^2) to O(n).
-    // If query call is repeated, simply start checking from the last checked index.
-    // If disk is still there, we can just return it, otherwise we can continue checking.
-    std::unordered_map<const Border<T>, int, BorderHash<T>> border_checked_index_cache;
-
-    // Map marking if disk with given index was deleted.
-    std::unordered_map<int, bool> deleted_disks;
-
-    // Radius of all disks in the structure should be the same.
-    T radius;
-
-    Point_and_index<T> disk_to_point(const Disk<T> &disk) const {
-        return std::make_tuple(
-                Point_2<T>(disk.center.x, disk.center.y),
-                disk.get_index()
-        );
+    static T coordinate(const Point<T> &p, int axis) {
+        return axis == 0 ? p.x : p.y;
+    }
+
+    // Build subtree over disks[begin .. end), low and high bound centers of these disks.
+    void build(int begin, int end, Point<T> low, Point<T> high) {
+        if (begin >= end) {
+            return;
+        }
+
+        const int middle = begin + (end - begin) / 2;
+        const int axis = high.x - low.x >= high.y - low.y ? 0 : 1;
+        std::nth_element(disks.begin() + begin, disks.begin() + middle, disks.begin() + end,
+                         [axis](const Disk<T> &a, const Disk<T> &b) {
+                             return coordinate(a.center, axis) < coordinate(b.center, axis);
+                         });
+        split_axis[middle] = axis;
+        subtree_live[middle] = end - begin;
+
+        // Bounds of centers of subtrees follow from the median (no need to scan the disks).
+        Point<T> left_high = high;
+        Point<T> right_low = low;
+        if (axis == 0) {
+            left_high.x = right_low.x = disks[middle].center.x;
+        } else {
+            left_high.y = right_low.y = disks[middle].center.y;
+        }
+        build(begin, middle, low, left_high);
+        build(middle + 1, end, right_low, high);
+    }
+
+    bool dead_in_view(int begin, int end, const AliveView &view) const {
+        return begin >= end ||
+               dead_subtrees.get(begin + (end - begin) / 2, view) == static_cast<uint32_t>(end - begin);
+    }
+
+    // Search subtree over disks[begin .. end) for a disk with center at most reach away from p, for which check
+    // returns true. Skips deleted disks, or disks dead in the view if there is one. Returns position of the disk or -1.
+    // Disks left of the median have coordinate (along the split axis) at most the median, disks right of it at least
+    // the median, so the other side only needs to be searched if p is closer than reach to the median along the axis.
+    template<class F>
+    int search(int begin, int end, const Point<T> &p, T reach, AliveView *view, uint64_t revision, F &check) {
+        if (begin >= end) {
+            return -1;
+        }
+
+        const int middle = begin + (end - begin) / 2;
+        if (view == nullptr ? subtree_live[middle] == 0 : dead_in_view(begin, end, *view)) {
+            return -1;
+        }
+        if (view == nullptr ? !is_deleted(middle) && check(middle)
+                            : check(middle) && view->alive(disks[middle].get_index())) {
+            return middle;
+        }
+
+        const int axis = split_axis[middle];
+        const T difference = coordinate(p, axis) - coordinate(disks[middle].center, axis);
+
+        // Side of p first.
+        int found = difference < 0
+                    ? search(begin, middle, p, reach, view, revision, check)
+                    : search(middle + 1, end, p, reach, view, revision, check);
+        if (found < 0 && difference * difference <= reach * reach) {
+            found = difference < 0
+                    ? search(middle + 1, end, p, reach, view, revision, check)
+                    : search(begin, middle, p, reach, view, revision, check);
+        }
+
+        // Stamp of the root is only read when both subtrees are dead.
+        if (found < 0 && view != nullptr && dead_in_view(begin, middle, *view) &&
+            dead_in_view(middle + 1, end, *view) && !view->alive(disks[middle].get_index())) {
+            dead_subtrees.set(middle, *view, revision, static_cast<uint32_t>(end - begin));
+        }
+        return found;
     }
 
-    Disk<T> point_to_disk(const Point_and_index<T> &point) const {
-        // Unpack point and index.
-        const Point_2<T> p = std::get<0>(point);
-        const int index = std::get<1>(point);
+    // Mark a live disk equal to the given one (with the same index, to tell copies apart) in the subtree as deleted,
+    // returns true if it was found.
+    bool erase(int begin, int end, const Disk<T> &disk) {
+        if (begin >= end) {
+            return false;
+        }
+
+        const int middle = begin + (end - begin) / 2;
+        if (subtree_live[middle] == 0) {
+            return false;
+        }
+
+        bool found = false;
+        if (!is_deleted(middle) && disks[middle] == disk && disks[middle].get_index() == disk.get_index()) {
+            deleted[middle >> 6] |= uint64_t(1) << (middle & 63);
+            found = true;
+        } else {
+            // Disks with the same coordinate as the median can be on both sides.
+            const int axis = split_axis[middle];
+            const T difference = coordinate(disk.center, axis) - coordinate(disks[middle].center, axis);
+            found = (difference <= 0 && erase(begin, middle, disk)) ||
+                    (difference >= 0 && erase(middle + 1, end, disk));
+        }
 
-        auto disk = Disk<T>{{p.x(), p.y()}, radius};
-        disk.unsafe_set_index(index);
-        return disk;
+        if (found) {
+            subtree_live[middle]--;
+        }
+        return found;
     }
 
 public:
     void rebuild(const std::vector<GeometryObject<T>> &objects) {
-        tree.clear();
-        disks = {};
+        borders.clear();
+        disks.clear();
+        border_checked_index_cache.clear();
+        radius = 0;
 
-        // Filter objects and add disks to the tree.
         for (const auto &o: objects) {
             if (is_disk(o)) {
-                auto disk = std::get<Disk<T>>(o);
-
-                // Insert into tree
-                tree.insert(disk_to_point(disk));
-                disks.push_back(disk);
-
-                // Check if radius is the same for all disks.
-                if (radius == 0) {
-                    radius = disk.radius;
-                } else {
-                    assert("Radius of all disk should be the same" && radius == disk.radius);
-                }
+                disks.push_back(std::get<Disk<T>>(o));
+                radius = std::max(radius, disks.back().radius);
             } else {
-                // This is a border.
-                auto border = std::get<Border<T>>(o);
-                borders.push_back(border);
+                borders.push_back(std::get<Border<T>>(o));
             }
         }
 
-        tree.build();
+        split_axis.assign(disks.size(), 0);
+        subtree_live.assign(disks.size(), 0);
+        deleted.assign((disks.size() + 63) / 64, 0);
+        dead_subtrees.assign(disks.size());
+
+        if (!disks.empty()) {
+            Point<T> low = disks[0].center;
+            Point<T> high = disks[0].center;
+            for (const auto &disk: disks) {
+                low = {std::min(low.x, disk.center.x), std::min(low.y, disk.center.y)};
+                high = {std::max(high.x, disk.center.x), std::max(high.y, disk.center.y)};
+            }
+            build(0, static_cast<int>(disks.size()), low, high);
+        }
     }
 
     // Given a disk D (not necessarily from the structure), return a disk D' that intersects D (if any).
     std::optional<GeometryObject<T>> intersecting(const GeometryObject<T> &object) {
-        if (!is_disk(object)) {
-            auto border = std::get<Border<T>>(object);
-
-            // Check intersection with borders
-            for (const auto &b: borders) {
-                if (intersects(border, b)) {
-                    return {b};
-                }
+        // Check intersection with borders
+        for (const auto &b: borders) {
+            if (intersects(object, static_cast<GeometryObject<T>>(b))) {
+                return {b};
             }
+        }
 
-            // Check intersection with disks.
-            // This is O(n) operation, but it's not a problem since it will be cached and amortized.
-
-            // Get last checked index for this border.
-            int last_checked_index = border_checked_index_cache[border];
-            if (last_checked_index >= disks.size()) {
-                // Checked all
-                return {};
-            }
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
 
-            for (int i = last_checked_index; i < disks.size(); i++) {
-                auto disk = disks[i];
-                // Check only not deleted disks.
-                if (!deleted_disks.contains(disk.get_index()) && intersects(border, disk)) {
-                    // Update last checked index.
-                    border_checked_index_cache[border] = i;
-                    return {disk};
+            // Check intersection with disks, amortized over all queries with the border.
+            std::size_t &last_checked_index = border_checked_index_cache[border];
+            for (; last_checked_index < disks.size(); last_checked_index++) {
+                const int i = static_cast<int>(last_checked_index);
+                if (!is_deleted(i) && intersects(border, disks[i])) {
+                    return {disks[i]};
                 }
             }
 
-            // Update last checked index.
-            border_checked_index_cache[border] = disks.size();
-
             return {};
         }
 
-        // Check intersection with borders
-        for (const auto &border: borders) {
-            if (intersects(object, static_cast<GeometryObject<T>>(border))) {
-                return {border};
-            }
+        const auto &disk = std::get<Disk<T>>(object);
+        auto check = [&](int i) { return intersects(disk, disks[i]); };
+        int found = search(0, static_cast<int>(disks.size()), disk.center, disk.radius + radius, nullptr, 0, check);
+        if (found < 0) {
+            return {};
         }
+        return {disks[found]};
+    }
 
-        auto disk = std::get<Disk<T>>(object);
-
-        // Query the tree for nearest neighbor.
-        NN<T> nn(tree, std::get<0>(disk_to_point(disk)));
-
-        auto it = nn.begin();
-        if (it != nn.end()) {
-            // Found a disk that intersects with the query disk.
-            auto point = it->first;
-            auto out_disk = point_to_disk(point);
+    // Given a disk or a border, return a disk alive in the view that intersects it (if any).
+    std::optional<Disk<T>> intersecting(const GeometryObject<T> &object, AliveView &view) {
+        if (!is_disk(object)) {
+            auto border = std::get<Border<T>>(object);
 
-            // We got the closest disk, but it might not intersect with the query disk.
-            if (intersects(object, static_cast<GeometryObject<T>>(out_disk))) {
-                return {out_disk};
+            // Same as above, but the last checked position is kept in the view.
+            for (std::size_t i = view.border_cursor; i < disks.size(); i++) {
+                if (view.alive(disks[i].get_index()) && intersects(border, disks[i])) {
+                    view.border_cursor = i;
+                    return {disks[i]};
+                }
             }
+            view.border_cursor = disks.size();
+
+            return {};
         }
 
-        return {};
+        const auto &disk = std::get<Disk<T>>(object);
+        auto check = [&](int i) { return intersects(disk, disks[i]); };
+        int found = search(0, static_cast<int>(disks.size()), disk.center, disk.radius + radius, &view,
+                           DeadPrefixes::revision(view), check);
+        if (found < 0) {
+            return {};
+        }
+        return {disks[found]};
     }
 
     // Delete object (if it exists) from the structure.
@@ -196,11 +267,7 @@ public:
             return;
         }
 
-        auto disk = std::get<Disk<T>>(o);
-
-        // Remove point representing the disk from the tree.
-        tree.remove(disk_to_point(disk));
-        deleted_disks[disk.get_index()] = true;
+        erase(0, static_cast<int>(disks.size()), std::get<Disk<T>>(o));
     }
 };
 
@@ -29,6 +29,31 @@ public:
         return {};
     }
 
+    // Given a disk or a border, return a disk alive in the view that intersects it (if any).
+    std::optional<Disk<T>> intersecting(const GeometryObject<T> &object, AliveView &view) {
+        // Disks are never removed in view queries, so border queries can continue where the previous one stopped.
+        const bool border_query = is_border(object);
+        std::size_t i = border_query ? view.border_cursor : 0;
+
+        for (; i < objects.size(); i++) {
+            if (!is_disk(objects[i])) {
+                continue;
+            }
+            const auto &disk = std::get<Disk<T>>(objects[i]);
+            if (view.alive(disk.get_index()) && intersects(objects[i], object)) {
+                if (border_query) {
+                    view.border_cursor = i;
+                }
+                return {disk};
+            }
+        }
+
+        if (border_query) {
+            view.border_cursor = objects.size();
+        }
+        return {};
+    }
+
     // Delete object (if it exists) from the structure.
     void delete_object(const GeometryObject<T> &o) {
         for (auto it = objects.begin(); it != objects.end(); ++it) {
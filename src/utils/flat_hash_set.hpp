@@ -0,0 +1,161 @@
+#ifndef UTILS_FLAT_HASH_SET_HPP
+#define UTILS_FLAT_HASH_SET_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cassert>
+
+// Mix bits of a key, so that keys which differ in a few low bits (packed vertices and edges) land far apart.
+// (finalizer of splitmix64)
+inline uint64_t mix_hash(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+
+// Set of 64-bit keys (packed vertices or edges, see pack_vertex and pack_edge) stored in a single flat array.
+// Open addressing with linear probing: lookups touch consecutive slots instead of following pointers to buckets, and
+// nothing is allocated per key. Table is kept at most half full.
+class FlatHashSet {
+private:
+    // Marks empty slot, never a valid key.
+    static constexpr uint64_t empty_key = UINT64_MAX;
+
+    std::vector<uint64_t> slots;
+    std::size_t count = 0;
+
+    std::size_t mask() const {
+        return slots.size() - 1;
+    }
+
+    std::size_t slot_of(uint64_t key) const {
+        return mix_hash(key) & mask();
+    }
+
+    void grow() {
+        std::vector<uint64_t> old_slots(slots.empty() ? 16 : 2 * slots.size(), empty_key);
+        old_slots.swap(slots);
+
+        count = 0;
+        for (auto key: old_slots) {
+            if (key != empty_key) {
+                insert(key);
+            }
+        }
+    }
+
+public:
+    FlatHashSet() = default;
+
+    // Set with enough space for given number of keys (no rehashing until then).
+    explicit FlatHashSet(std::size_t expected_size) {
+        std::size_t capacity = 16;
+        while (capacity < 2 * expected_size) {
+            capacity *= 2;
+        }
+        slots.assign(capacity, empty_key);
+    }
+
+    // Insert key, returns false if it was already in the set.
+    bool insert(uint64_t key) {
+        assert(key != empty_key);
+        if (2 * (count + 1) > slots.size()) {
+            grow();
+        }
+
+        std::size_t i = slot_of(key);
+        while (slots[i] != empty_key) {
+            if (slots[i] == key) {
+                return false;
+            }
+            i = (i + 1) & mask();
+        }
+
+        slots[i] = key;
+        count++;
+        return true;
+    }
+
+    bool contains(uint64_t key) const {
+        if (slots.empty()) {
+            return false;
+        }
+
+        std::size_t i = slot_of(key);
+        while (slots[i] != empty_key) {
+            if (slots[i] == key) {
+                return true;
+            }
+            i = (i + 1) & mask();
+        }
+        return false;
+    }
+
+    // Remove key, returns false if it was not in the set.
+    bool erase(uint64_t key) {
+        if (slots.empty()) {
+            return false;
+        }
+
+        std::size_t i = slot_of(key);
+        while (slots[i] != key) {
+            if (slots[i] == empty_key) {
+                return false;
+            }
+            i = (i + 1) & mask();
+        }
+
+        // Backward shift deletion: move following keys of the probe sequence into the hole, so there are no
+        // tombstones and lookups stay short.
+        std::size_t hole = i;
+        std::size_t j = i;
+        while (true) {
+            j = (j + 1) & mask();
+            if (slots[j] == empty_key) {
+                break;
+            }
+            // Key at j can move to the hole if its home slot is not in the (cyclic) range (hole, j].
+            std::size_t home = slot_of(slots[j]);
+            if (((j - home) & mask()) >= ((j - hole) & mask())) {
+                slots[hole] = slots[j];
+                hole = j;
+            }
+        }
+
+        slots[hole] = empty_key;
+        count--;
+        return true;
+    }
+
+    // Remove all keys, keeps allocated space.
+    void clear() {
+        std::fill(slots.begin(), slots.end(), empty_key);
+        count = 0;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    // Call f for every key in the set (in no particular order).
+    template<class F>
+    void for_each(F f) const {
+        for (auto key: slots) {
+            if (key != empty_key) {
+                f(key);
+            }
+        }
+    }
+};
+
+#endif //UTILS_FLAT_HASH_SET_HPP
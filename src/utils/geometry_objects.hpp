@@ -91,7 +91,8 @@ template<class T>
 class BorderHash {
 public:
     size_t operator()(const Border<T> &border) const {
-        return std::hash<T>()(border.x) ^ std::hash<bool>()(border.left);
+        // (XOR of the hashes would put left border at x and right border at x ^ 1 into the same bucket)
+        return std::hash<T>()(border.x) * 31 + std::hash<bool>()(border.left);
     }
 };
 
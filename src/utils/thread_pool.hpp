@@ -0,0 +1,105 @@
+#ifndef UTILS_THREAD_POOL_HPP
+#define UTILS_THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <latch>
+#include <algorithm>
+
+// Fixed set of threads shared by all parallel steps of a solve.
+// Threads are started once and wait for tasks, so a parallel step costs a few synchronizations instead of starting
+// new threads. Thread calling parallel_for also does its share of work.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable task_available;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+
+    void worker_loop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex);
+                task_available.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    // Stopping and nothing left to do
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        task_available.notify_one();
+    }
+
+public:
+    // Pool running tasks on given number of threads (including the thread which calls parallel_for).
+    explicit ThreadPool(int number_of_threads) {
+        for (int i = 1; i < number_of_threads; i++) {
+            workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        task_available.notify_all();
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    // Number of threads which run tasks.
+    int size() const {
+        return static_cast<int>(workers.size()) + 1;
+    }
+
+    // Call f(i) for all i in [0, count) in parallel and wait until all calls are done.
+    // Indices are handed out one by one, so calls of different length are balanced between threads.
+    // Calls should not call parallel_for themselves (threads waiting for nested calls could block the whole pool).
+    template<class F>
+    void parallel_for(std::size_t count, F f) {
+        std::atomic<std::size_t> next_index = 0;
+        auto work = [&next_index, count, &f] {
+            for (std::size_t i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1)) {
+                f(i);
+            }
+        };
+
+        const auto helpers = static_cast<std::ptrdiff_t>(std::min(workers.size(), count > 0 ? count - 1 : 0));
+        std::latch helpers_done(helpers);
+        for (std::ptrdiff_t h = 0; h < helpers; h++) {
+            submit([&work, &helpers_done] {
+                work();
+                helpers_done.count_down();
+            });
+        }
+
+        work();
+        helpers_done.wait();
+    }
+};
+
+#endif //UTILS_THREAD_POOL_HPP
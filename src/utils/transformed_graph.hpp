@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <iostream>
+#include <cstdint>
+#include "flat_hash_set.hpp"
 
 // Vertex in transformed graph.
 // (in original graph G, vertices are disks + s and t)
@@ -77,21 +79,42 @@ public:
 // The path is represented as a sequence of edges from G'
 using Path = std::vector<Edge>;
 
+// Vertex packed into 32 bits: (disk_index + 1) << 1 | inbound.
+// Source is 0, sink is 1, outbound and inbound vertex of disk i are 2 * i + 2 and 2 * i + 3.
+inline uint32_t pack_vertex(const TransformedVertex &v) {
+    return (static_cast<uint32_t>(v.disk_index + 1) << 1) | (v.inbound ? 1u : 0u);
+}
+
+inline TransformedVertex unpack_vertex(uint32_t packed) {
+    return {static_cast<int>(packed >> 1) - 1, (packed & 1) == 1};
+}
+
+// Edge packed into 64 bits: from in high and to in low 32 bits.
+// (edge and its reverse edge have different keys)
+inline uint64_t pack_edge(const Edge &e) {
+    return (static_cast<uint64_t>(pack_vertex(e.from)) << 32) | pack_vertex(e.to);
+}
+
+inline Edge unpack_edge(uint64_t packed) {
+    return {unpack_vertex(static_cast<uint32_t>(packed >> 32)), unpack_vertex(static_cast<uint32_t>(packed))};
+}
+
 // Custom hash function for transformed vertices.
+// (hashes packed vertex, XOR of disk index and inbound flag would put (2k, out) and (2k + 1, in) into the same bucket)
 class TransformedVertexHash {
 public:
     size_t operator()(const TransformedVertex &vertex) const {
-        return std::hash<int>()(vertex.disk_index) ^ std::hash<bool>()(vertex.inbound);
+        return mix_hash(pack_vertex(vertex));
     }
 };
 
 // Custom hash function for edges.
+// (hashes packed edge, XOR of vertex hashes would put v -> u and u -> v into the same bucket)
 class EdgeHash {
 public:
     size_t operator()(const Edge &edge) const {
-        return TransformedVertexHash()(edge.from) ^ ~TransformedVertexHash()(edge.to);
+        return mix_hash(pack_edge(edge));
     }
 };
 
-
 #endif //UTILS_TRANSFORMED_GRAPH_HPP
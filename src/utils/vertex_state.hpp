@@ -0,0 +1,167 @@
+#ifndef UTILS_VERTEX_STATE_HPP
+#define UTILS_VERTEX_STATE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <atomic>
+#include "transformed_graph.hpp"
+
+// Dense per-vertex state for the transformed graph G'.
+//
+// Every vertex of G' is a pair (disk_index, inbound) with disk_index in [-1, n), so instead of hash maps keyed by
+// vertices we can keep all per-vertex state in flat arrays of size 2n + 2, indexed by vertex_id:
+// - 0 is the source and 1 is the sink,
+// - 2 * i + 2 is the outbound and 2 * i + 3 the inbound vertex of disk i.
+
+// (vertex_id is the packed vertex, see pack_vertex)
+inline int vertex_id(const TransformedVertex &v) {
+    return static_cast<int>(pack_vertex(v));
+}
+
+inline TransformedVertex vertex_from_id(int id) {
+    return unpack_vertex(static_cast<uint32_t>(id));
+}
+
+// Number of vertices of G' for given number of disks (inbound and outbound vertex for each disk + source and sink).
+inline int number_of_vertices(int number_of_disks) {
+    return 2 * number_of_disks + 2;
+}
+
+
+// Level (BFS distance from source) of each vertex.
+// Vertices are also bucketed by level in the order in which they were added, so all vertices of a single level can be
+// listed without going over all vertices of the graph.
+class VertexLevels {
+private:
+    // Level of each vertex, -1 if vertex was not reached.
+    std::vector<int32_t> level;
+
+    // buckets[l] contains all vertices with level l.
+    std::vector<std::vector<TransformedVertex>> buckets;
+
+    // Number of vertices with assigned level.
+    std::size_t count = 0;
+
+public:
+    VertexLevels() = default;
+
+    explicit VertexLevels(int number_of_disks) : level(number_of_vertices(number_of_disks), -1) {}
+
+    bool contains(const TransformedVertex &v) const {
+        return level[vertex_id(v)] != -1;
+    }
+
+    // Level of a vertex, -1 if vertex was not reached.
+    int32_t operator[](const TransformedVertex &v) const {
+        return level[vertex_id(v)];
+    }
+
+    // Assign level to a vertex which has no level yet.
+    void set(const TransformedVertex &v, int32_t l) {
+        assert(!contains(v) && l >= 0);
+
+        level[vertex_id(v)] = l;
+        if (buckets.size() <= static_cast<std::size_t>(l)) {
+            buckets.resize(l + 1);
+        }
+        buckets[l].push_back(v);
+        count++;
+    }
+
+    // Remove all vertices with given level.
+    void clear_level(int32_t l) {
+        if (buckets.size() <= static_cast<std::size_t>(l)) {
+            return;
+        }
+        for (const auto &v: buckets[l]) {
+            level[vertex_id(v)] = -1;
+        }
+        count -= buckets[l].size();
+        buckets[l].clear();
+    }
+
+    // All vertices with given level.
+    const std::vector<TransformedVertex> &vertices_with_level(int32_t l) const {
+        static const std::vector<TransformedVertex> empty;
+        if (l < 0 || buckets.size() <= static_cast<std::size_t>(l)) {
+            return empty;
+        }
+        return buckets[l];
+    }
+
+    // Number of vertices with assigned level.
+    std::size_t size() const {
+        return count;
+    }
+};
+
+
+// Link from a vertex to another vertex (e.g. previous or next vertex on a path).
+class VertexLinks {
+private:
+    // Vertex id of linked vertex, -1 if vertex has no link.
+    std::vector<int32_t> link;
+
+public:
+    VertexLinks() = default;
+
+    explicit VertexLinks(int number_of_disks) : link(number_of_vertices(number_of_disks), -1) {}
+
+    bool contains(const TransformedVertex &v) const {
+        return link[vertex_id(v)] != -1;
+    }
+
+    // Linked vertex, v must have a link.
+    TransformedVertex operator[](const TransformedVertex &v) const {
+        assert(contains(v));
+        return vertex_from_id(link[vertex_id(v)]);
+    }
+
+    // True if v has a link and it points to u.
+    bool points_to(const TransformedVertex &v, const TransformedVertex &u) const {
+        return link[vertex_id(v)] == vertex_id(u);
+    }
+
+    void set(const TransformedVertex &v, const TransformedVertex &u) {
+        link[vertex_id(v)] = vertex_id(u);
+    }
+
+    void erase(const TransformedVertex &v) {
+        link[vertex_id(v)] = -1;
+    }
+};
+
+
+// Set of vertices, stored as a bitset.
+// Words are read and claimed atomically, so multiple threads can claim vertices of the same set.
+class VertexSet {
+private:
+    std::vector<uint64_t> words;
+
+public:
+    VertexSet() = default;
+
+    explicit VertexSet(int number_of_disks) : words((number_of_vertices(number_of_disks) + 63) / 64, 0) {}
+
+    bool contains(const TransformedVertex &v) const {
+        int id = vertex_id(v);
+        uint64_t word = std::atomic_ref(const_cast<uint64_t &>(words[id / 64])).load(std::memory_order_relaxed);
+        return (word >> (id % 64)) & 1;
+    }
+
+    void insert(const TransformedVertex &v) {
+        int id = vertex_id(v);
+        words[id / 64] |= uint64_t(1) << (id % 64);
+    }
+
+    // Insert vertex, safe to call from multiple threads at once.
+    // Returns true if vertex was not in the set yet (exactly one of the threads which claim the same vertex succeeds).
+    bool claim(const TransformedVertex &v) {
+        int id = vertex_id(v);
+        uint64_t bit = uint64_t(1) << (id % 64);
+        return (std::atomic_ref(words[id / 64]).fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    }
+};
+
+#endif //UTILS_VERTEX_STATE_HPP
@@ -17,45 +17,63 @@ Graph create_bfs_tree(std::vector<int> parent) {
     return g;
 }
 
+// Iterative DFS is local to this file (blocking_family.cpp has its own DfsFrame).
+namespace {
+
+// Frame of the iterative DFS: vertex and index of the next neighbour to check.
+struct DfsFrame {
+    int vertex;
+    unsigned int next_neighbour;
+};
+
 // Returns true if found a single path -> dfs must be terminated immediately.
+// DFS is iterative, frames are kept in a stack buffer owned by the caller (reused between calls), so path length is
+// not limited by the size of the call stack.
 bool dfs(const Graph &g, std::vector<bool> &visited, int start,
-         int end, std::vector<int> &path, std::vector<std::vector<int>> &paths) {
-    path.push_back(start);
-
-    if (start == end) {
-        // We found a path from start to end.
+         int end, std::vector<DfsFrame> &stack, std::vector<std::vector<int>> &paths) {
+    stack.clear();
+    stack.push_back({start, 0});
+
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+
+        if (frame.vertex == end) {
+            // We found a path from start to end.
+            // Vertices on the stack form the path, copy them to paths.
+            std::vector<int> path;
+            path.reserve(stack.size());
+            for (const auto &f: stack) {
+                path.push_back(f.vertex);
+            }
+            paths.push_back(path);
 
-        // Copy path to paths.
-        std::vector<int> path_copy(path);
-        paths.push_back(path_copy);
-        path.clear();
+            // All vertices in path are already marked as visited, so we can terminate dfs.
+            return true;
+        }
 
-        // All vertices in path are already marked as visited, so we can terminate dfs.
-        return true;
-    }
+        if (frame.next_neighbour == g[frame.vertex].size()) {
+            // All neighbours checked, remove vertex from path.
+            stack.pop_back();
+            continue;
+        }
 
-    // Check all neighbours.
-    for (int v: g[start]) {
+        // Check next neighbour.
+        int v = g[frame.vertex][frame.next_neighbour++];
         if (!visited[v]) {
             // Mark neighbour as visited, except for end node.
             if (v != end) {
                 visited[v] = true;
             }
-            // Recursively call dfs.
-            bool found_path = dfs(g, visited, v, end, path, paths);
-
-            if (found_path) {
-                // We found a path, so we can terminate dfs.
-                return true;
-            }
+            // Continue dfs from neighbour (frame reference is not used after this point).
+            stack.push_back({v, 0});
         }
     }
 
-    // Remove start from path.
-    path.pop_back();
     return false;
 }
 
+} // namespace
+
 
 // Perform DFS on BFS tree. When we find end node, we add the path to the set of paths.
 //
@@ -67,12 +85,13 @@ bool dfs(const Graph &g, std::vector<bool> &visited, int start,
 std::vector<std::vector<int>> dfs_on_bfs_tree(const Graph &g, int start, int end) {
     std::vector<std::vector<int>> paths;
     std::vector<bool> visited(g.size(), false);
+    // Stack of the DFS, reused between runs.
+    std::vector<DfsFrame> stack;
 
     // Run DFS on BFS tree.
     while (true) {
         // Start DFS from start node.
-        std::vector<int> path;
-        bool found_path = dfs(g, visited, start, end, path, paths);;
+        bool found_path = dfs(g, visited, start, end, stack, paths);
 
         if (!found_path) {
             // We didn't find any path, so we can terminate.
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "barrier_resilience/augmenting_path.hpp"
+#include "barrier_resilience/barrier_resilience.hpp"
+#include "with_graph_construction/graph_barrier_resilience.hpp"
+
+TEST(TestAugmentingPath, TestSinglePaths) {
+    const auto config = Config<int>::with_trivial_datastructure();
+
+    // Two separate chains crossing the strip, second one is longer
+    std::vector<Disk<int>> disks;
+    for (int x = 0; x <= 12; x += 4) {
+        disks.push_back({{x, 0}, 2});
+    }
+    for (int x = 0; x <= 12; x += 3) {
+        disks.push_back({{x, 20}, 2});
+    }
+    add_index_to_disks(disks);
+    auto index = SpatialIndex<int>(disks, config);
+    auto flow = FlowState(disks.size());
+
+    for (int i = 0; i < 2; i++) {
+        auto path = find_augmenting_path(flow, disks, 0, 12, index);
+        ASSERT_TRUE(path.has_value());
+        ASSERT_EQ(path.value().front().from, source);
+        ASSERT_EQ(path.value().back().to, sink);
+        flow.augment(path.value());
+    }
+
+    // Flow is maximum, both paths are blocked right after source
+    auto final_levels = VertexLevels(disks.size());
+    ASSERT_FALSE(find_augmenting_path(flow, disks, 0, 12, index, &final_levels).has_value());
+    ASSERT_TRUE(final_levels.contains(source));
+    ASSERT_FALSE(final_levels.contains(sink));
+    ASSERT_FALSE(final_levels.contains({0, true}));
+
+    // Borders intersect, path without disks does not count
+    ASSERT_FALSE(find_augmenting_path(FlowState(disks.size()), disks, 0, 0, index).has_value());
+}
+
+TEST(TestAugmentingPath, TestMaximumFlow) {
+    const auto config = Config<int>::with_trivial_datastructure();
+
+    // Augmenting single paths from the empty flow gives the maximum flow
+    for (int _ = 0; _ < 200; _++) {
+        int width = 1 + rand() % 20;
+        std::vector<Disk<int>> disks;
+        for (int i = 0; i < 1 + rand() % 40; i++) {
+            disks.push_back({{rand() % width, rand() % 20}, 1 + rand() % 5});
+        }
+        add_index_to_disks(disks);
+
+        auto index = SpatialIndex<int>(disks, config);
+        auto flow = FlowState(disks.size());
+        int path_count = 0;
+        while (true) {
+            auto path = find_augmenting_path(flow, disks, 0, width, index);
+            if (!path.has_value()) {
+                break;
+            }
+            flow.augment(path.value());
+            path_count++;
+        }
+
+        ASSERT_EQ(path_count, graph_barrier_resilience_number_of_disks(disks, 0, width));
+    }
+}
@@ -234,9 +234,9 @@ TEST(TestBarrierResilience, TestDisksBug) {
     ASSERT_EQ(d, std::vector<int>({0, 11, 14}));
 }
 
-TEST(TestBarrierResilience, TestMatchingWithSimplerImplementation) {
-    const auto config = Config<int>::with_trivial_datastructure();
-
+// Compare number of disks returned by graph implementation and by this implementation with given config on random
+// problems.
+void assert_matches_simpler_implementation(const Config<int> &config) {
     auto random = []() { return rand() % 1234567; };
 
     // Test if responses from graph implementation always match responses from this implementation.
@@ -265,6 +265,7 @@ TEST(TestBarrierResilience, TestMatchingWithSimplerImplementation) {
             // Solve problem with graph construction
             int sol1 = graph_barrier_resilience_number_of_disks(disks, left_border_x, right_border_x);
             int sol2 = barrier_resilience_number_of_disks(disks, left_border_x, right_border_x, config);
+            ASSERT_EQ(barrier_resilience_disks(disks, left_border_x, right_border_x, config).size(), sol2);
 
             if (sol1 != sol2) {
                 // Re-run with disk output to see what's wrong
@@ -289,4 +290,295 @@ TEST(TestBarrierResilience, TestMatchingWithSimplerImplementation) {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(TestBarrierResilience, TestMatchingWithSimplerImplementation) {
+    assert_matches_simpler_implementation(Config<int>::with_trivial_datastructure());
+}
+
+TEST(TestBarrierResilience, TestMatchingWithSimplerImplementationOnHierarchicalGrid) {
+    assert_matches_simpler_implementation(Config<int>::with_hierarchical_grid());
+}
+
+TEST(TestBarrierResilience, TestMatchingWithSimplerImplementationOnBVH) {
+    auto config = Config<int>::with_bvh();
+    assert_matches_simpler_implementation(config);
+
+    // Bottom-up layers build a new structure for every layer
+    config.direction_optimizing_bfs = true;
+    assert_matches_simpler_implementation(config);
+}
+
+TEST(TestBarrierResilience, TestShortestPathPruning) {
+    auto config = Config<int>::with_trivial_datastructure();
+    config.shortest_path_pruning = true;
+    assert_matches_simpler_implementation(config);
+
+    // Corridor with many disks hanging off a single chain - most of the level graph is not on a shortest path
+    std::vector<Disk<int>> disks;
+    for (int i = 0; i < 10; i++) {
+        disks.push_back({{2 * i, 0}, 1});
+        // Columns of disks above every other disk of the chain (columns do not touch each other)
+        for (int j = 1; j < 5 && i % 2 == 0; j++) {
+            disks.push_back({{2 * i, 2 * j}, 1});
+        }
+    }
+
+    Statistics statistics;
+    config.statistics = &statistics;
+    ASSERT_EQ(barrier_resilience_number_of_disks(disks, 0, 18, config), 1);
+    ASSERT_GT(statistics.pruned_level_vertices, 0);
+}
+
+TEST(TestBarrierResilience, TestDirectionOptimizingBfs) {
+    auto config = Config<int>::with_trivial_datastructure();
+    config.direction_optimizing_bfs = true;
+    assert_matches_simpler_implementation(config);
+
+    // Dense problem, last layers are large compared to the number of unvisited disks
+    std::vector<Disk<int>> disks;
+    for (int i = 0; i < 500; i++) {
+        disks.push_back({{rand() % 100, rand() % 100}, 10});
+    }
+
+    Statistics statistics;
+    config.statistics = &statistics;
+    auto top_down_config = Config<int>::with_trivial_datastructure();
+
+    ASSERT_EQ(barrier_resilience_number_of_disks(disks, 0, 100, config),
+              barrier_resilience_number_of_disks(disks, 0, 100, top_down_config));
+    ASSERT_GT(statistics.bottom_up_layers, 0);
+    ASSERT_GT(statistics.top_down_layers, 0);
+}
+
+TEST(TestBarrierResilience, TestSplitComponents) {
+    auto config = Config<int>::with_trivial_datastructure();
+    config.split_components = true;
+    assert_matches_simpler_implementation(config);
+
+    // Components solved in parallel
+    config.threads = 4;
+    assert_matches_simpler_implementation(config);
+}
+
+TEST(TestBarrierResilience, TestPruneDeadEnds) {
+    auto config = Config<int>::with_trivial_datastructure();
+    config.prune_dead_ends = true;
+    assert_matches_simpler_implementation(config);
+
+    // Together with components
+    config.split_components = true;
+    config.threads = 4;
+    assert_matches_simpler_implementation(config);
+
+    // Chain with columns of disks hanging off every other disk, all columns except the first one (which touches the
+    // left border) are dead ends
+    std::vector<Disk<int>> disks;
+    for (int i = 0; i < 10; i++) {
+        disks.push_back({{2 * i, 0}, 1});
+        for (int j = 1; j < 5 && i % 2 == 0; j++) {
+            disks.push_back({{2 * i, 2 * j}, 1});
+        }
+    }
+
+    Statistics statistics;
+    config.statistics = &statistics;
+    ASSERT_EQ(barrier_resilience_number_of_disks(disks, 0, 18, config), 1);
+    ASSERT_EQ(statistics.input_disks, 30);
+    ASSERT_EQ(statistics.pruned_disks, 16);
+    ASSERT_DOUBLE_EQ(statistics.pruned_disks_ratio(), 16.0 / 30.0);
+
+    // Returned disk is on the chain
+    auto d = barrier_resilience_disks(disks, 0, 18, config);
+    ASSERT_EQ(d.size(), 1);
+    ASSERT_EQ(disks[d[0]].center.y, 0);
+}
+
+TEST(TestBarrierResilience, TestWarmStart) {
+    auto config = Config<int>::with_trivial_datastructure();
+    config.warm_start = true;
+    assert_matches_simpler_implementation(config);
+
+    // Together with other preprocessing
+    config.prune_dead_ends = true;
+    config.split_components = true;
+    assert_matches_simpler_implementation(config);
+
+    // Separated horizontal chains are all found by the greedy packing, phases find nothing more
+    std::vector<Disk<int>> disks;
+    for (int y = 0; y < 50; y += 5) {
+        for (int x = 0; x <= 20; x += 2) {
+            disks.push_back({{x, y}, 1});
+        }
+    }
+
+    Statistics statistics;
+    config = Config<int>::with_trivial_datastructure();
+    config.warm_start = true;
+    config.statistics = &statistics;
+    ASSERT_EQ(barrier_resilience_number_of_disks(disks, 0, 20, config), 10);
+    ASSERT_EQ(barrier_resilience_disks(disks, 0, 20, config).size(), 10);
+    ASSERT_EQ(statistics.warm_start_paths, 20);
+    ASSERT_EQ(statistics.paths, 20);
+    ASSERT_EQ(statistics.phases, 0);
+}
+
+TEST(TestBarrierResilience, TestHybridPhases) {
+    auto config = Config<int>::with_trivial_datastructure();
+    config.hybrid_phases = true;
+    assert_matches_simpler_implementation(config);
+
+    // Short chain is found by the first phase (a single path), long chain by a single path search
+    std::vector<Disk<int>> disks;
+    for (int x = 0; x <= 12; x += 4) {
+        disks.push_back({{x, 0}, 2});
+    }
+    for (int x = 0; x <= 12; x += 3) {
+        disks.push_back({{x, 20}, 2});
+    }
+
+    Statistics statistics;
+    config.statistics = &statistics;
+    ASSERT_EQ(barrier_resilience_number_of_disks(disks, 0, 12, config), 2);
+    ASSERT_EQ(barrier_resilience_disks(disks, 0, 12, config).size(), 2);
+    ASSERT_EQ(statistics.phases, 2);
+    ASSERT_EQ(statistics.single_path_searches, 2);
+    ASSERT_EQ(statistics.paths, 4);
+    ASSERT_GT(statistics.single_path_threshold, 0);
+}
+
+TEST(TestBarrierResilience, TestAtLeast) {
+    auto config = Config<int>::with_trivial_datastructure();
+
+    // Random problems, answer has to match the number of disks for every k
+    for (int _ = 0; _ < 300; _++) {
+        int width = 1 + rand() % 20;
+        std::vector<Disk<int>> disks;
+        for (int i = 0; i < 1 + rand() % 60; i++) {
+            disks.push_back({{rand() % width, rand() % 30}, 1 + rand() % 5});
+        }
+
+        config.hybrid_phases = rand() % 2;
+        config.prune_dead_ends = rand() % 2;
+        config.split_components = rand() % 2;
+        int number_of_disks = barrier_resilience_number_of_disks(disks, 0, width, config);
+        for (int k = 0; k <= number_of_disks + 2; k++) {
+            ASSERT_EQ(barrier_resilience_at_least(disks, 0, width, k, config), number_of_disks >= k);
+        }
+    }
+
+    // Dense problem, both early exits save phases
+    std::vector<Disk<int>> disks;
+    for (int i = 0; i < 2000; i++) {
+        disks.push_back({{rand() % 100, rand() % 200}, 5});
+    }
+    config = Config<int>::with_trivial_datastructure();
+    int number_of_disks = barrier_resilience_number_of_disks(disks, 0, 100, config);
+
+    Statistics full, low, high;
+    config.statistics = &full;
+    barrier_resilience_number_of_disks(disks, 0, 100, config);
+    config.statistics = &low;
+    ASSERT_TRUE(barrier_resilience_at_least(disks, 0, 100, number_of_disks / 4, config));
+    config.statistics = &high;
+    ASSERT_FALSE(barrier_resilience_at_least(disks, 0, 100, 4 * number_of_disks, config));
+
+    ASSERT_LT(low.phases, full.phases);
+    ASSERT_LT(high.phases, full.phases);
+
+    // Two separate bands of disks are two components, the first path found in any of them answers k = 1
+    disks.clear();
+    for (int i = 0; i < 2000; i++) {
+        disks.push_back({{rand() % 100, rand() % 200 + (i % 2) * 1000}, 5});
+    }
+    config = Config<int>::with_trivial_datastructure();
+    config.split_components = true;
+    Statistics split_full, split_low;
+    config.statistics = &split_full;
+    number_of_disks = barrier_resilience_number_of_disks(disks, 0, 100, config);
+    config.statistics = &split_low;
+    ASSERT_TRUE(barrier_resilience_at_least(disks, 0, 100, 1, config));
+    ASSERT_EQ(split_low.phases, 1);
+    ASSERT_LT(split_low.phases, split_full.phases);
+    config.statistics = nullptr;
+    ASSERT_FALSE(barrier_resilience_at_least(disks, 0, 100, number_of_disks + 1, config));
+}
+
+TEST(TestBarrierResilience, TestAnytime) {
+    const auto config = Config<int>::with_trivial_datastructure();
+    const auto no_deadline = std::chrono::steady_clock::time_point::max();
+
+    for (int _ = 0; _ < 300; _++) {
+        int width = 1 + rand() % 20;
+        std::vector<Disk<int>> disks;
+        for (int i = 0; i < 1 + rand() % 60; i++) {
+            disks.push_back({{rand() % width, rand() % 30}, 1 + rand() % 5});
+        }
+        int number_of_disks = barrier_resilience_number_of_disks(disks, 0, width, config);
+
+        // Bounds reported to the callback only get tighter
+        int last_lower_bound = 0;
+        int last_upper_bound = static_cast<int>(disks.size());
+        auto callback = [&](int lower_bound, int upper_bound) {
+            ASSERT_GE(lower_bound, last_lower_bound);
+            ASSERT_LE(upper_bound, last_upper_bound);
+            ASSERT_LE(lower_bound, number_of_disks);
+            ASSERT_GE(upper_bound, number_of_disks);
+            last_lower_bound = lower_bound;
+            last_upper_bound = upper_bound;
+        };
+
+        // Without deadline, result is exact
+        auto result = barrier_resilience_anytime(disks, 0, width, no_deadline, callback, config);
+        ASSERT_EQ(result.lower_bound, number_of_disks);
+        ASSERT_EQ(result.upper_bound, number_of_disks);
+        ASSERT_EQ(result.disks_if_exact.size(), number_of_disks);
+        ASSERT_EQ(last_lower_bound, number_of_disks);
+
+        // Deadline has already passed, bounds are still valid
+        result = barrier_resilience_anytime(disks, 0, width, std::chrono::steady_clock::now(), {}, config);
+        ASSERT_LE(result.lower_bound, number_of_disks);
+        ASSERT_GE(result.upper_bound, number_of_disks);
+        if (result.lower_bound == result.upper_bound) {
+            ASSERT_EQ(result.disks_if_exact.size(), number_of_disks);
+        } else {
+            ASSERT_TRUE(result.disks_if_exact.empty());
+        }
+    }
+
+    // Deadline is kept when components are solved separately, no component runs a phase after it
+    std::vector<Disk<int>> disks;
+    for (int i = 0; i < 2000; i++) {
+        disks.push_back({{rand() % 100, rand() % 200 + (i % 2) * 1000}, 5});
+    }
+    for (int threads: {1, 4}) {
+        auto split_config = Config<int>::with_trivial_datastructure();
+        split_config.split_components = true;
+        split_config.threads = threads;
+        Statistics statistics;
+        split_config.statistics = &statistics;
+        auto result = barrier_resilience_anytime(disks, 0, 100, std::chrono::steady_clock::now(), {}, split_config);
+        ASSERT_EQ(statistics.phases, 0);
+        ASSERT_EQ(result.lower_bound, 0);
+        ASSERT_GT(result.upper_bound, 0);
+    }
+}
+
+TEST(TestBarrierResilience, TestGridDataStructure) {
+    // Disks with same radius, compare with trivial data structure
+    const auto trivial_config = Config<int>::with_trivial_datastructure();
+    auto config = Config<int>::with_grid();
+
+    for (int _ = 0; _ < 100; _++) {
+        int width = 1 + rand() % 50;
+        int radius = 1 + rand() % 5;
+        std::vector<Disk<int>> disks;
+        for (int i = 0; i < 1 + rand() % 200; i++) {
+            disks.push_back({{rand() % width, rand() % 100}, radius});
+        }
+
+        config.direction_optimizing_bfs = rand() % 2;
+        ASSERT_EQ(barrier_resilience_number_of_disks(disks, 0, width, config),
+                  barrier_resilience_number_of_disks(disks, 0, width, trivial_config));
+    }
+}
@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
 #include <vector>
+#include <pthread.h>
 
 #include "data_structure/trivial.hpp"
 #include "utils/geometry_objects.hpp"
 #include "barrier_resilience/blocking_family.hpp"
+#include "barrier_resilience/barrier_resilience.hpp"
 
 TEST(TestBlockingFamily, TestEmptyPaths) {
     const auto config = Config<int>::with_trivial_datastructure();
@@ -39,9 +41,10 @@ TEST(TestBlockingFamily, TestEmptyPaths) {
     // Expect two paths of length 3
     family = find_blocking_family<int>(blocked_edges, disks, left_border, right_border, config);
     // In case of different data structures, order of paths may be different.
+    // (vertices of each level are visited in the order in which BFS found them)
     expected = {
-            {{source, {1, true}}, {{1, true}, {1, false}}, {{1, false}, sink}},
             {{source, {0, true}}, {{0, true}, {0, false}}, {{0, false}, sink}},
+            {{source, {1, true}}, {{1, true}, {1, false}}, {{1, false}, sink}},
     };
     EXPECT_EQ(family.size(), 2);
     EXPECT_EQ(family, expected);
@@ -312,4 +315,138 @@ TEST(TestBlockingFamily, TestNoDisks) {
     // (you still cannot walk from bottom to top, even if all disks are removed).
     family = find_blocking_family<int>(no_blocked_edges, disks, 0, 0, config);
     EXPECT_EQ(family, (std::vector<std::vector<Edge>>{}));
-}
\ No newline at end of file
+}
+TEST(TestBlockingFamily, TestLongChainOnSmallStack) {
+    // Single chain of touching disks from left to right border.
+    // DFS in the layered graph has to go along the whole chain (two vertices per disk), so this fails if the search
+    // needs a call stack frame per vertex. Run it in a thread with a small stack to make the check strict.
+    struct Problem {
+        std::vector<Disk<int>> disks;
+        int result = -1;
+    } problem;
+
+    const int n = 3000;
+    for (int i = 0; i < n; i++) {
+        problem.disks.push_back({{2 * i, 0}, 1});
+    }
+
+    auto solve = [](void *arg) -> void * {
+        auto *p = static_cast<Problem *>(arg);
+        const auto config = Config<int>::with_trivial_datastructure();
+        p->result = barrier_resilience_number_of_disks<int>(p->disks, 0, 2 * (n - 1), config);
+        return nullptr;
+    };
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 256 * 1024);
+
+    pthread_t thread;
+    ASSERT_EQ(pthread_create(&thread, &attr, solve, &problem), 0);
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attr);
+
+    ASSERT_EQ(problem.result, 1);
+}
+
+TEST(TestBlockingFamily, TestParallelWorkersFindBlockingFamily) {
+    auto config = Config<int>::with_trivial_datastructure();
+    auto parallel_config = config;
+    parallel_config.threads = 4;
+
+    // Narrow and dense strip, so that there are many disjoint paths in each phase
+    auto disks = std::vector<Disk<int>>();
+    for (int i = 0; i < 3000; i++) {
+        disks.push_back(Disk<int>{{rand() % 40, rand() % 1500}, 5});
+    }
+    add_index_to_disks(disks);
+
+    auto index = SpatialIndex<int>(disks, parallel_config);
+    auto flow = FlowState(disks.size());
+    int path_count = 0;
+    int distance = 0;
+
+    while (true) {
+        auto family = find_blocking_family<int>(flow, disks, 0, 40, index, parallel_config);
+        if (family.empty()) {
+            break;
+        }
+
+        // Paths are vertex disjoint
+        auto used = VertexSet(disks.size());
+        for (const auto &path: family) {
+            for (const auto &e: path) {
+                if (e.to != sink) {
+                    ASSERT_TRUE(used.claim(e.to));
+                }
+            }
+            flow.augment(path);
+        }
+        path_count += family.size();
+
+        // Family is blocking - distance to sink strictly increases after each phase
+        auto r = find_levels<int>(flow, disks, 0, 40, index, parallel_config);
+        ASSERT_TRUE(!r.reachable || r.distance > distance);
+        distance = r.distance;
+    }
+
+    ASSERT_EQ(path_count, barrier_resilience_number_of_disks(disks, 0, 40, config));
+}
+
+TEST(TestBlockingFamily, TestLevelBuildStatistics) {
+    auto config = Config<int>::with_trivial_datastructure();
+    config.threads = 2;
+    Statistics statistics;
+    config.statistics = &statistics;
+
+    // Chain of 5 disks, distance to sink is 11
+    auto disks = std::vector<Disk<int>>();
+    for (int i = 0; i < 5; i++) {
+        disks.push_back(Disk<int>{{2 * i, 0}, 1});
+    }
+    add_index_to_disks(disks);
+
+    auto family = find_blocking_family<int>(std::vector<Edge>{}, disks, 0, 8, config);
+    ASSERT_EQ(family.size(), 1);
+
+    // Build time is reported for every level (only odd levels have views)
+    ASSERT_EQ(statistics.level_build_time.size(), 12);
+    for (int i = 0; i < 12; i += 2) {
+        ASSERT_EQ(statistics.level_build_time[i], 0);
+    }
+    for (int i = 1; i < 11; i += 2) {
+        ASSERT_GE(statistics.level_build_time[i], 0);
+    }
+}
+
+TEST(TestBlockingFamily, TestFinalLevels) {
+    const auto config = Config<int>::with_trivial_datastructure();
+
+    // Chain of two disks, disk 0 touches left border, disk 1 touches right border
+    auto disks = std::vector<Disk<int>>{
+            {{0, 0}, 1},
+            {{2, 0}, 1},
+    };
+    add_index_to_disks(disks);
+    auto index = SpatialIndex<int>(disks, config);
+    auto flow = FlowState(disks.size());
+
+    // Flow is not maximum yet, final levels are not touched
+    auto final_levels = VertexLevels(disks.size());
+    auto family = find_blocking_family<int>(flow, disks, 0, 2, index, config, &final_levels);
+    ASSERT_EQ(family.size(), 1);
+    ASSERT_FALSE(final_levels.contains(source));
+
+    for (const auto &path: family) {
+        flow.augment(path);
+    }
+
+    // Flow is maximum, edge from source to disk 0 is used, so only source is reachable in the residual graph
+    family = find_blocking_family<int>(flow, disks, 0, 2, index, config, &final_levels);
+    ASSERT_TRUE(family.empty());
+    ASSERT_TRUE(final_levels.contains(source));
+    ASSERT_FALSE(final_levels.contains({0, true}));
+    ASSERT_FALSE(final_levels.contains({0, false}));
+    ASSERT_FALSE(final_levels.contains({1, true}));
+    ASSERT_FALSE(final_levels.contains(sink));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "barrier_resilience/barrier_resilience.hpp"
+#include "barrier_resilience/components.hpp"
+
+// Three horizontal chains of disks: two of them cross the strip [0, 10], the third one touches only the left border.
+std::vector<Disk<int>> three_chains() {
+    std::vector<Disk<int>> disks;
+    // Chain at y = 0, crosses the strip (disks 0..5)
+    for (int x = 0; x <= 10; x += 2) {
+        disks.push_back({{x, 0}, 1});
+    }
+    // Chain at y = 10, touches only the left border (disks 6..8)
+    for (int x = 0; x <= 4; x += 2) {
+        disks.push_back({{x, 10}, 1});
+    }
+    // Two parallel touching chains at y = 20 and y = 22, cross the strip (disks 9..20)
+    for (int x = 0; x <= 10; x += 2) {
+        disks.push_back({{x, 20}, 1});
+        disks.push_back({{x, 22}, 1});
+    }
+    add_index_to_disks(disks);
+    return disks;
+}
+
+TEST(TestComponents, TestBorderToBorderComponents) {
+    auto disks = three_chains();
+    const auto config = Config<int>::with_trivial_datastructure();
+    auto index = SpatialIndex<int>(disks, config);
+
+    auto components = border_to_border_components(disks, 0, 10, index);
+
+    // Largest component first, component touching only the left border is dropped
+    ASSERT_EQ(components.size(), 2);
+    ASSERT_EQ(components[0], std::vector<int>({9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20}));
+    ASSERT_EQ(components[1], std::vector<int>({0, 1, 2, 3, 4, 5}));
+}
+
+TEST(TestComponents, TestSolveByComponents) {
+    auto disks = three_chains();
+
+    for (int threads: {1, 4}) {
+        auto config = Config<int>::with_trivial_datastructure();
+        config.split_components = true;
+        config.threads = threads;
+
+        Statistics statistics;
+        config.statistics = &statistics;
+
+        // One disk from the single chain, two disks from the double chain
+        ASSERT_EQ(barrier_resilience_number_of_disks(disks, 0, 10, config), 3);
+        ASSERT_GT(statistics.phases, 0);
+
+        // Returned indices refer to the input, not to the component
+        auto d = barrier_resilience_disks(disks, 0, 10, config);
+        ASSERT_EQ(d.size(), 3);
+        ASSERT_TRUE(std::is_sorted(d.begin(), d.end()));
+        ASSERT_LE(d[0], 5);
+        ASSERT_GE(d[1], 9);
+        ASSERT_GE(d[2], 9);
+    }
+
+    // No component crosses the strip
+    auto config = Config<int>::with_trivial_datastructure();
+    config.split_components = true;
+    ASSERT_EQ(barrier_resilience_number_of_disks(disks, -5, 10, config), 0);
+    ASSERT_TRUE(barrier_resilience_disks(disks, -5, 10, config).empty());
+}
+
+TEST(TestComponents, TestBorderToBorderChainDisks) {
+    // Chain at y = 0 from left to right border (disks 0..5)
+    std::vector<Disk<int>> disks;
+    for (int x = 0; x <= 10; x += 2) {
+        disks.push_back({{x, 0}, 1});
+    }
+    // Branch hanging off disk 2 (disks 6..8), dead end
+    for (int y = 2; y <= 6; y += 2) {
+        disks.push_back({{4, y}, 1});
+    }
+    // Bypass of disk 3 (disks 9..11), on the cycle 2 - 9 - 10 - 11 - 4 - 3 - 2, so on a chain
+    disks.push_back({{4, -2}, 1});
+    disks.push_back({{6, -2}, 1});
+    disks.push_back({{8, -2}, 1});
+    // Loop attached to disk 5 only through a single disk (disks 12..14), dead end
+    disks.push_back({{12, 2}, 1});
+    disks.push_back({{11, 4}, 1});
+    disks.push_back({{13, 4}, 1});
+    // Disk touching only the left border (disk 15), dead end
+    disks.push_back({{-1, 10}, 1});
+    add_index_to_disks(disks);
+
+    const auto config = Config<int>::with_trivial_datastructure();
+    auto index = SpatialIndex<int>(disks, config);
+
+    ASSERT_EQ(border_to_border_chain_disks(disks, 0, 10, index),
+              std::vector<int>({0, 1, 2, 3, 4, 5, 9, 10, 11}));
+
+    // No chain from left to right border
+    ASSERT_TRUE(border_to_border_chain_disks(disks, -5, 10, index).empty());
+}
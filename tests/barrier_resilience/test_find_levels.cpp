@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "data_structure/trivial.hpp"
 #include "barrier_resilience/find_levels.hpp"
+#include "barrier_resilience/blocking_family.hpp"
 #include <vector>
 
 TEST(TestFindLevels, TestEmptyPaths) {
@@ -310,7 +311,7 @@ TEST(TestFindLevels, TestEmptyPathsUnreachable) {
     // L[4]
     ASSERT_EQ((r.levels[TransformedVertex{1, false}]), 4);
     // No level for t
-    ASSERT_TRUE(r.levels.find(sink) == r.levels.end());
+    ASSERT_FALSE(r.levels.contains(sink));
     ASSERT_EQ(r.distance, -1);
 
     // Another layout
@@ -353,7 +354,7 @@ TEST(TestFindLevels, TestEmptyPathsUnreachable) {
     // L[6]
     ASSERT_EQ((r.levels[TransformedVertex{2, false}]), 6);
     // No level for t
-    ASSERT_TRUE(r.levels.find(sink) == r.levels.end());
+    ASSERT_FALSE(r.levels.contains(sink));
     ASSERT_EQ(r.distance, -1);
 }
 
@@ -413,7 +414,7 @@ TEST(TestFindLevels, TestUnreachable) {
     // L[5] - inbound vertex of disk 0
     ASSERT_EQ((r.levels[TransformedVertex{0, true}]), 5);
     // No level for t
-    ASSERT_TRUE(r.levels.find(sink) == r.levels.end());
+    ASSERT_FALSE(r.levels.contains(sink));
     ASSERT_EQ(r.distance, -1);
 }
 
@@ -604,4 +605,35 @@ TEST(TestFindLevels, NoDisks) {
     r = find_levels<int>(blocked_edges, disks, 0, 0, config);
     ASSERT_TRUE(r.reachable);
     ASSERT_EQ(r.distance, 1);
-}
\ No newline at end of file
+}
+TEST(TestFindLevels, TestParallelMatchesSequential) {
+    auto config = Config<int>::with_trivial_datastructure();
+    auto parallel_config = config;
+    parallel_config.threads = 4;
+
+    // Narrow and dense strip, so that layers are large enough to be expanded in parallel
+    auto disks = std::vector<Disk<int>>();
+    for (int i = 0; i < 6000; i++) {
+        disks.push_back(Disk<int>{{rand() % 40, rand() % 3000}, 5});
+    }
+    add_index_to_disks(disks);
+
+    // Few paths, so that there are also reverse edges in the residual graph
+    std::vector<Edge> blocked_edges;
+    auto family = find_blocking_family<int>(blocked_edges, disks, 0, 40, config);
+    for (const auto &path: family) {
+        blocked_edges.insert(blocked_edges.end(), path.begin(), path.end());
+    }
+
+    for (const auto &edges: {std::vector<Edge>{}, blocked_edges}) {
+        auto r = find_levels<int>(edges, disks, 0, 40, config);
+        auto parallel_r = find_levels<int>(edges, disks, 0, 40, parallel_config);
+
+        ASSERT_EQ(r.reachable, parallel_r.reachable);
+        ASSERT_EQ(r.distance, parallel_r.distance);
+        ASSERT_EQ(r.levels.size(), parallel_r.levels.size());
+        for (int id = 0; id < number_of_vertices(disks.size()); id++) {
+            ASSERT_EQ(r.levels[vertex_from_id(id)], parallel_r.levels[vertex_from_id(id)]);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "barrier_resilience/flow_state.hpp"
+
+TEST(TestFlowState, TestAugment) {
+    auto flow = FlowState(4);
+
+    // First path: source -> 0 -> 1 -> sink
+    flow.augment({{source, {0, true}},
+                  {{0, true}, {0, false}},
+                  {{0, false}, {1, true}},
+                  {{1, true}, {1, false}},
+                  {{1, false}, sink}});
+
+    ASSERT_TRUE((flow.contains({{0, false}, {1, true}})));
+    ASSERT_TRUE((flow.prev.points_to({1, true}, {0, false})));
+    ASSERT_TRUE((flow.next.points_to({1, false}, sink)));
+    ASSERT_FALSE((flow.prev.contains({2, true})));
+
+    // Second path goes against the flow on edge 0 -> 1: source -> 2 -> 1_in -> 0_out -> 3 -> sink
+    // Edge 0_out -> 1_in is cancelled, 1_in gets a new previous vertex and 0_out a new next vertex.
+    flow.augment({{source, {2, true}},
+                  {{2, true}, {2, false}},
+                  {{2, false}, {1, true}},
+                  {{1, true}, {0, false}},
+                  {{0, false}, {3, true}},
+                  {{3, true}, {3, false}},
+                  {{3, false}, sink}});
+
+    ASSERT_FALSE((flow.contains({{0, false}, {1, true}})));
+    ASSERT_FALSE((flow.contains({{1, true}, {0, false}})));
+
+    // Paths are now source -> 0 -> 3 -> sink and source -> 2 -> 1 -> sink
+    ASSERT_TRUE((flow.contains({{0, false}, {3, true}})));
+    ASSERT_TRUE((flow.contains({{2, false}, {1, true}})));
+    ASSERT_TRUE((flow.contains({{1, true}, {1, false}})));
+    ASSERT_TRUE((flow.prev.points_to({0, true}, source)));
+    ASSERT_TRUE((flow.prev.points_to({2, true}, source)));
+    ASSERT_TRUE((flow.next.points_to({1, false}, sink)));
+    ASSERT_TRUE((flow.next.points_to({3, false}, sink)));
+}
+
+TEST(TestFlowState, TestFromEdges) {
+    const auto edges = std::vector<Edge>{{source, {0, true}},
+                                         {{0, true}, {0, false}},
+                                         {{0, false}, sink}};
+    auto flow = FlowState(2, edges);
+
+    for (const auto &e: edges) {
+        ASSERT_TRUE(flow.contains(e));
+    }
+    ASSERT_FALSE((flow.prev.contains({1, true})));
+    ASSERT_FALSE((flow.next.contains({1, false})));
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "barrier_resilience/upper_bound.hpp"
+#include "barrier_resilience/config.hpp"
+#include "with_graph_construction/graph_barrier_resilience.hpp"
+
+// Disks without the given ones
+std::vector<Disk<int>> without_disks(const std::vector<Disk<int>> &disks, const std::vector<int> &removed) {
+    std::vector<Disk<int>> result;
+    for (int i = 0; i < static_cast<int>(disks.size()); i++) {
+        if (std::find(removed.begin(), removed.end(), i) == removed.end()) {
+            result.push_back(disks[i]);
+        }
+    }
+    return result;
+}
+
+TEST(TestUpperBound, TestBfsLayerCut) {
+    const auto config = Config<int>::with_trivial_datastructure();
+
+    // Two chains joined in the middle by a single disk
+    std::vector<Disk<int>> disks = {
+            {{0, 0}, 1}, {{0, 6}, 1}, {{2, 0}, 1}, {{2, 6}, 1},
+            {{4, 3}, 3},
+            {{6, 0}, 1}, {{6, 6}, 1}, {{8, 0}, 1}, {{8, 6}, 1},
+    };
+    add_index_to_disks(disks);
+    auto index = SpatialIndex<int>(disks, config);
+
+    ASSERT_EQ(bfs_layer_cut(disks, 0, 8, index), std::vector<int>({4}));
+
+    // Chains do not reach the right border
+    ASSERT_TRUE(bfs_layer_cut(disks, 0, 12, index).empty());
+}
+
+TEST(TestUpperBound, TestBfsLayerCutIsCut) {
+    const auto config = Config<int>::with_trivial_datastructure();
+
+    for (int _ = 0; _ < 300; _++) {
+        int width = 1 + rand() % 20;
+        std::vector<Disk<int>> disks;
+        for (int i = 0; i < 1 + rand() % 40; i++) {
+            disks.push_back({{rand() % width, rand() % 20}, 1 + rand() % 5});
+        }
+        add_index_to_disks(disks);
+        auto index = SpatialIndex<int>(disks, config);
+
+        auto cut = bfs_layer_cut(disks, 0, width, index);
+
+        // Cut is at least as large as the minimum one and removing it opens a way
+        ASSERT_GE(cut.size(), graph_barrier_resilience_number_of_disks(disks, 0, width));
+        ASSERT_EQ(graph_barrier_resilience_number_of_disks(without_disks(disks, cut), 0, width), 0);
+    }
+}
+
+TEST(TestUpperBound, TestCrossingCurveCut) {
+    // Two rows of disks with a gap in each, curve goes through both gaps without crossing anything
+    std::vector<Disk<int>> disks;
+    for (int x = 0; x <= 20; x += 2) {
+        if (x != 4) {
+            disks.push_back({{x, 0}, 1});
+        }
+        if (x != 16) {
+            disks.push_back({{x, 10}, 1});
+        }
+    }
+    ASSERT_TRUE(crossing_curve_cut<int>(disks, 0, 20).empty());
+
+    // Without gaps, a curve has to cross one disk in each row
+    disks.push_back({{4, 0}, 1});
+    disks.push_back({{16, 10}, 1});
+    ASSERT_EQ(crossing_curve_cut<int>(disks, 0, 20).size(), 2);
+
+    // Borders intersect
+    ASSERT_TRUE(crossing_curve_cut<int>(disks, 0, 0).empty());
+}
+
+TEST(TestUpperBound, TestCrossingCurveCutIsCut) {
+    for (int _ = 0; _ < 300; _++) {
+        int width = 1 + rand() % 20;
+        std::vector<Disk<int>> disks;
+        for (int i = 0; i < 1 + rand() % 40; i++) {
+            disks.push_back({{rand() % width, rand() % 20}, 1 + rand() % 5});
+        }
+
+        auto cut = crossing_curve_cut<int>(disks, 0, width);
+
+        // Cut is at least as large as the minimum one and removing it opens a way
+        ASSERT_GE(cut.size(), graph_barrier_resilience_number_of_disks(disks, 0, width));
+        ASSERT_EQ(graph_barrier_resilience_number_of_disks(without_disks(disks, cut), 0, width), 0);
+    }
+}
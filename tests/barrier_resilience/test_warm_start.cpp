@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <set>
+#include "barrier_resilience/warm_start.hpp"
+#include "barrier_resilience/config.hpp"
+
+TEST(TestWarmStart, TestGreedyPathPacking) {
+    const auto config = Config<int>::with_trivial_datastructure();
+
+    // Three horizontal chains from left to right border and a vertical chain touching all of them
+    std::vector<Disk<int>> disks;
+    for (int y: {20, 0, 10}) {
+        for (int x = 0; x <= 10; x += 2) {
+            disks.push_back({{x, y}, 1});
+        }
+    }
+    for (int y = 2; y <= 18; y += 2) {
+        disks.push_back({{5, y}, 1});
+    }
+    add_index_to_disks(disks);
+    auto index = SpatialIndex<int>(disks, config);
+
+    auto paths = greedy_path_packing(disks, 0, 10, index);
+    ASSERT_GE(paths.size(), 1);
+    ASSERT_LE(paths.size(), 3);
+
+    // Paths are vertex disjoint paths from source to sink in G'
+    std::set<int> used_disks;
+    for (const auto &path: paths) {
+        ASSERT_EQ(path.front().from, source);
+        ASSERT_EQ(path.back().to, sink);
+        for (std::size_t i = 0; i + 1 < path.size(); i++) {
+            ASSERT_EQ(path[i].to, path[i + 1].from);
+        }
+        for (std::size_t i = 1; i + 1 < path.size(); i += 2) {
+            // Edge v_in -> v_out of a disk
+            ASSERT_EQ(path[i].from.disk_index, path[i].to.disk_index);
+            ASSERT_TRUE(path[i].from.inbound);
+            ASSERT_FALSE(path[i].to.inbound);
+            ASSERT_TRUE(used_disks.insert(path[i].from.disk_index).second);
+        }
+        for (std::size_t i = 2; i + 1 < path.size(); i += 2) {
+            // Edge between intersecting disks
+            ASSERT_TRUE(intersects(disks[path[i].from.disk_index], disks[path[i].to.disk_index]));
+        }
+    }
+
+    // First chain starts at the lowest disk touching the left border
+    ASSERT_EQ(paths[0][0].to.disk_index, 6);
+
+    // Borders intersect, nothing to pack
+    ASSERT_TRUE(greedy_path_packing(disks, 0, 0, index).empty());
+}
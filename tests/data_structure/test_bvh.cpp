@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include "data_structure/bvh.hpp"
+#include "data_structure/trivial.hpp"
+#include <vector>
+
+void assert_bvh_query_is_correct(BVH<int> &bvh, Trivial<int> &naive, const GeometryObject<int> &object) {
+    auto d1 = bvh.intersecting(object);
+    auto d2 = naive.intersecting(object);
+
+    // Check if both solutions agree
+    ASSERT_EQ(d1.has_value(), d2.has_value());
+
+    if (d1.has_value() && d2.has_value()) {
+        // Values might be different, but response is correct as long as d1 is intersecting disk
+        ASSERT_TRUE(intersects(d1.value(), object));
+    }
+}
+
+TEST(TestBVH, TestQuery) {
+    // Disks with different radii
+    const auto objects = std::vector<GeometryObject<int>>{
+            Disk<int>{{0, 0}, 1},
+            Disk<int>{{20, 0}, 10},
+            Disk<int>{{0, 100}, 50},
+            Border<int>{200, false},
+    };
+
+    auto t = BVH<int>();
+    t.rebuild(objects);
+
+    ASSERT_EQ(t.intersecting(Disk<int>{{-1, 0}, 1}), objects[0]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{8, 0}, 2}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{31, 0}, 1}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-50, 100}, 1}), objects[2]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{190, 0}, 20}), objects[3]);
+
+    // Query objects that don't intersect any disk or border
+    ASSERT_EQ(t.intersecting(Disk<int>{{4, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{100, 0}, 50}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, -100}, 20}), std::nullopt);
+
+    // Query with border, expect intersection with disk
+    ASSERT_EQ(t.intersecting(Border<int>{-45, true}), objects[2]);
+}
+
+TEST(TestBVH, TestDeletion) {
+    const auto objects = std::vector<GeometryObject<int>>{
+            Disk<int>{{0, 0}, 1},
+            Disk<int>{{0, 0}, 30},
+            Border<int>{-100, true},
+    };
+
+    auto t = BVH<int>();
+    t.rebuild(objects);
+
+    ASSERT_EQ(t.intersecting(Disk<int>{{25, 0}, 1}), objects[1]);
+    t.delete_object(Disk<int>{{0, 0}, 30});
+    ASSERT_EQ(t.intersecting(Disk<int>{{25, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{1, 0}, 1}), objects[0]);
+
+    // Disks which are not in the structure
+    t.delete_object(Disk<int>{{1, 0}, 1});
+    t.delete_object(Disk<int>{{0, 0}, 1000});
+    ASSERT_EQ(t.intersecting(Disk<int>{{1, 0}, 1}), objects[0]);
+
+    t.delete_object(Disk<int>{{0, 0}, 1});
+    ASSERT_EQ(t.intersecting(Disk<int>{{1, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), objects[2]);
+
+    t.delete_object(Border<int>{-100, true});
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), std::nullopt);
+}
+
+TEST(TestBVH, TestDisksOnSamePoint) {
+    auto disks = std::vector<Disk<int>>(100, Disk<int>{{0, 0}, 1});
+    add_index_to_disks(disks);
+    const auto objects = std::vector<GeometryObject<int>>(disks.begin(), disks.end());
+
+    auto t = BVH<int>();
+    t.rebuild({});
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Border<int>{0, true}), std::nullopt);
+
+    // Copies differ only by index, deletion removes the given copy
+    t.rebuild(objects);
+    for (int i = 1; i < 100; i += 2) {
+        t.delete_object(disks[i]);
+    }
+
+    // Remaining copies are found one by one, until all are deleted
+    auto found = std::vector<int>();
+    while (auto disk = t.intersecting(Border<int>{0, true})) {
+        found.push_back(std::get<Disk<int>>(disk.value()).get_index());
+        t.delete_object(disk.value());
+    }
+    std::sort(found.begin(), found.end());
+    ASSERT_EQ(found.size(), 50);
+    for (int i = 0; i < 50; i++) {
+        ASSERT_EQ(found[i], 2 * i);
+    }
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Border<int>{0, true}), std::nullopt);
+}
+
+TEST(TestBVH, TestLargerCase) {
+    // Generate large random test case with radii from 1 to 50 and compare with naive solution
+    auto random = []() { return rand() % 2233; };
+
+    auto objects = std::vector<GeometryObject<int>>();
+    for (int i = 0; i < 1000; ++i) {
+        objects.push_back(Disk<int>{{random(), random()}, 1 + rand() % 50});
+    }
+
+    auto bvh = BVH<int>();
+    auto naive = Trivial<int>();
+    bvh.rebuild(objects);
+    naive.rebuild(objects);
+
+    // 1000 random queries
+    for (int i = 0; i < 1000; ++i) {
+        assert_bvh_query_is_correct(bvh, naive, Disk<int>{{random(), random()}, 1 + rand() % 50});
+    }
+
+    // Delete disks intersecting right border one by one
+    while (true) {
+        auto found = bvh.intersecting(Border<int>{2000, false});
+        assert_bvh_query_is_correct(bvh, naive, Border<int>{2000, false});
+        if (!found.has_value()) {
+            break;
+        }
+        bvh.delete_object(found.value());
+        naive.delete_object(found.value());
+    }
+
+    // 500 random deletions
+    for (int i = 0; i < 500; ++i) {
+        auto disk = objects[rand() % objects.size()];
+        bvh.delete_object(disk);
+        naive.delete_object(disk);
+    }
+
+    // 1000 random queries
+    for (int i = 0; i < 1000; ++i) {
+        assert_bvh_query_is_correct(bvh, naive, Disk<int>{{random(), random()}, 1 + rand() % 50});
+    }
+}
+
+TEST(TestBVH, TestQueryOnViews) {
+    // Random disks, mixed radii
+    auto disks = std::vector<Disk<int>>();
+    for (int i = 0; i < 1000; i++) {
+        disks.push_back(Disk<int>{{rand() % 500, rand() % 500}, 1 + rand() % 40});
+    }
+    add_index_to_disks(disks);
+
+    const auto objects = std::vector<GeometryObject<int>>(disks.begin(), disks.end());
+    auto bvh = BVH<int>();
+    bvh.rebuild(objects);
+    auto naive = Trivial<int>();
+    naive.rebuild(objects);
+
+    auto stamps = AliveStamps(disks.size());
+    auto view = AliveView::all_disks(stamps, stamps.reserve(1));
+
+    // Delete disks from the view, both structures should see the same alive disks
+    auto erased = std::vector<int>();
+    for (int i = 0; i < 1000; i++) {
+        auto query = Disk<int>{{rand() % 500, rand() % 500}, 1 + rand() % 40};
+        auto d1 = bvh.intersecting(query, view);
+        auto d2 = naive.intersecting(query, view);
+        ASSERT_EQ(d1.has_value(), d2.has_value());
+
+        if (d1.has_value()) {
+            ASSERT_TRUE(intersects(d1.value(), query));
+            ASSERT_TRUE(view.alive(d1.value().get_index()));
+            view.erase(d1.value().get_index());
+            erased.push_back(d1.value().get_index());
+        }
+    }
+
+    // Disks added back to the view are found again, also in nodes which were pruned for the view
+    for (int i = 0; i < 1000; i++) {
+        if (i % 4 == 0 && !erased.empty()) {
+            view.insert(erased.back());
+            erased.pop_back();
+        }
+
+        auto query = Disk<int>{{rand() % 500, rand() % 500}, 1 + rand() % 40};
+        auto d1 = bvh.intersecting(query, view);
+        auto d2 = naive.intersecting(query, view);
+        ASSERT_EQ(d1.has_value(), d2.has_value());
+
+        if (d1.has_value()) {
+            ASSERT_TRUE(view.alive(d1.value().get_index()));
+            view.erase(d1.value().get_index());
+        }
+    }
+
+    // Border queries continue where the previous one stopped, and find all disks intersecting the border
+    auto border_view = AliveView::all_disks(stamps, stamps.reserve(1));
+    int found = 0;
+    while (auto disk = bvh.intersecting(Border<int>{30, true}, border_view)) {
+        ASSERT_TRUE(intersects(disk.value(), Border<int>{30, true}));
+        border_view.erase(disk.value().get_index());
+        found++;
+    }
+    ASSERT_EQ(found, std::count_if(disks.begin(), disks.end(), [](const Disk<int> &disk) {
+        return intersects(disk, Border<int>{30, true});
+    }));
+}
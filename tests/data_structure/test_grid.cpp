@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include "data_structure/grid.hpp"
+#include "data_structure/trivial.hpp"
+#include "utils/thread_pool.hpp"
+#include <vector>
+#include <latch>
+
+void assert_grid_query_is_correct(Grid<int> &grid, Trivial<int> &naive, const GeometryObject<int> &object) {
+    auto d1 = grid.intersecting(object);
+    auto d2 = naive.intersecting(object);
+
+    // Check if both solutions agree
+    ASSERT_EQ(d1.has_value(), d2.has_value());
+
+    if (d1.has_value() && d2.has_value()) {
+        // Values might be different, but response is correct as long as d1 is intersecting disk
+        ASSERT_TRUE(intersects(d1.value(), object));
+    }
+}
+
+TEST(TestGrid, TestQuery) {
+    // Disks with same radius
+    const auto objects = std::vector<GeometryObject<int>>{
+            Disk<int>{{0, 0}, 1},
+            Disk<int>{{2, 2}, 1},
+            Border<int>{10, false},
+    };
+
+    auto t = Grid<int>();
+    t.rebuild(objects);
+
+    // Query objects and check if we always get intersecting disk
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 0}, 1}), objects[0]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-1, 0}, 1}), objects[0]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{2, 0}, 1}), objects[0]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{4, 2}, 1}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{5, 2}, 2}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-5, -5}, 8}), objects[0]);
+
+    // Check intersection with border
+    ASSERT_EQ(t.intersecting(Border<int>{9, false}), objects[2]);
+    ASSERT_EQ(t.intersecting(Border<int>{100, false}), objects[2]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{9, 0}, 2}), objects[2]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{100, 0}, 2}), objects[2]);
+
+    // Query objects that don't intersect any disk or border
+    ASSERT_EQ(t.intersecting(Disk<int>{{-2, -2}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{5, 5}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 50}), std::nullopt);
+
+    // Query with border, expect intersection with disk
+    ASSERT_EQ(t.intersecting(Border<int>{0, true}), objects[0]);
+}
+
+TEST(TestGrid, TestDeletion) {
+    const auto objects = std::vector<GeometryObject<int>>{
+            Disk<int>{{0, 0}, 1},
+            Disk<int>{{2, 2}, 1},
+            Disk<int>{{4, 4}, 1},
+            Disk<int>{{100, 100}, 1},
+            Border<int>{-100, true},
+    };
+
+    auto t = Grid<int>();
+    t.rebuild(objects);
+
+    // Delete objects and check if they are deleted
+    t.delete_object(Disk<int>{{0, 0}, 1});
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{2, 1}, 1}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{4, 5}, 1}), objects[2]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{100, 101}, 1}), objects[3]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), objects[4]);
+
+    t.delete_object(Disk<int>{{2, 2}, 1});
+    ASSERT_EQ(t.intersecting(Disk<int>{{2, 1}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{4, 5}, 1}), objects[2]);
+
+    // Deleting a disk which is not in the structure does nothing
+    t.delete_object(Disk<int>{{4, 5}, 1});
+    t.delete_object(Disk<int>{{-1000, 1000}, 1});
+    ASSERT_EQ(t.intersecting(Disk<int>{{4, 5}, 1}), objects[2]);
+
+    t.delete_object(Disk<int>{{4, 4}, 1});
+    ASSERT_EQ(t.intersecting(Disk<int>{{4, 5}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{100, 101}, 1}), objects[3]);
+
+    t.delete_object(Disk<int>{{100, 100}, 1});
+    ASSERT_EQ(t.intersecting(Disk<int>{{100, 101}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), objects[4]);
+
+    t.delete_object(Border<int>{-100, true});
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), std::nullopt);
+}
+
+TEST(TestGrid, TestLargerCase) {
+    // Generate large random test case and compare with naive solution
+    auto random = []() { return rand() % 2233; };
+    const auto r = 10;
+
+    auto objects = std::vector<GeometryObject<int>>();
+
+    for (int i = 0; i < 1000; ++i) {
+        objects.push_back(Disk<int>{{random(), random()}, r});
+    }
+
+    auto grid = Grid<int>();
+    auto naive = Trivial<int>();
+    grid.rebuild(objects);
+    naive.rebuild(objects);
+
+    // 1000 random queries
+    for (int i = 0; i < 1000; ++i) {
+        assert_grid_query_is_correct(grid, naive, Disk<int>{{random(), random()}, r});
+    }
+
+    // Delete disks intersecting left border one by one, border queries continue in the cached cell
+    while (true) {
+        auto found = grid.intersecting(Border<int>{100, true});
+        assert_grid_query_is_correct(grid, naive, Border<int>{100, true});
+        if (!found.has_value()) {
+            break;
+        }
+        grid.delete_object(found.value());
+        naive.delete_object(found.value());
+    }
+
+    // 500 random deletions
+    for (int i = 0; i < 500; ++i) {
+        auto disk = objects[rand() % objects.size()];
+        grid.delete_object(disk);
+        naive.delete_object(disk);
+    }
+
+    // 1000 random queries, also with larger query disks
+    for (int i = 0; i < 1000; ++i) {
+        assert_grid_query_is_correct(grid, naive, Disk<int>{{random(), random()}, r + i % 30});
+    }
+    assert_grid_query_is_correct(grid, naive, Border<int>{2100, false});
+}
+
+TEST(TestGrid, TestSparseDisks) {
+    // Disks far apart, grid should not have a cell for every 2r x 2r square
+    const auto objects = std::vector<GeometryObject<double>>{
+            Disk<double>{{0, 0}, 0.5},
+            Disk<double>{{1e9, 1e9}, 0.5},
+            Disk<double>{{1e9 + 0.9, 1e9}, 0.5},
+    };
+
+    auto t = Grid<double>();
+    t.rebuild(objects);
+
+    ASSERT_EQ(t.intersecting(Disk<double>{{0.5, 0.5}, 0.5}), objects[0]);
+    ASSERT_EQ(t.intersecting(Disk<double>{{1e9 - 0.9, 1e9}, 0.5}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<double>{{5e8, 5e8}, 0.5}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Border<double>{1e9 + 1.2, false}), objects[2]);
+}
+
+TEST(TestGrid, TestDeleteCopies) {
+    // Copies of the same disk differ only by index, deletion removes the given copy
+    auto disks = std::vector<Disk<int>>(5, Disk<int>{{0, 0}, 1});
+    add_index_to_disks(disks);
+
+    auto grid = Grid<int>();
+    grid.rebuild(std::vector<GeometryObject<int>>(disks.begin(), disks.end()));
+    grid.delete_object(disks[2]);
+    grid.delete_object(disks[0]);
+
+    auto found = std::vector<int>();
+    while (auto disk = grid.intersecting(Disk<int>{{0, 0}, 1})) {
+        found.push_back(std::get<Disk<int>>(disk.value()).get_index());
+        grid.delete_object(disk.value());
+    }
+    std::sort(found.begin(), found.end());
+    ASSERT_EQ(found, (std::vector<int>{1, 3, 4}));
+}
+
+TEST(TestGrid, TestQueryOnViews) {
+    // Random disks, same radius
+    auto disks = std::vector<Disk<int>>();
+    for (int i = 0; i < 1000; i++) {
+        disks.push_back(Disk<int>{{rand() % 200, rand() % 200}, 5});
+    }
+    add_index_to_disks(disks);
+
+    const auto objects = std::vector<GeometryObject<int>>(disks.begin(), disks.end());
+    auto grid = Grid<int>();
+    grid.rebuild(objects);
+    auto naive = Trivial<int>();
+    naive.rebuild(objects);
+
+    auto stamps = AliveStamps(disks.size());
+    auto view = AliveView::all_disks(stamps, stamps.reserve(1));
+
+    // Delete disks from the view, both structures should see the same alive disks
+    auto erased = std::vector<int>();
+    for (int i = 0; i < 1000; i++) {
+        auto query = Disk<int>{{rand() % 200, rand() % 200}, 5};
+        auto d1 = grid.intersecting(query, view);
+        auto d2 = naive.intersecting(query, view);
+        ASSERT_EQ(d1.has_value(), d2.has_value());
+
+        if (d1.has_value()) {
+            ASSERT_TRUE(intersects(d1.value(), query));
+            ASSERT_TRUE(view.alive(d1.value().get_index()));
+            view.erase(d1.value().get_index());
+            erased.push_back(d1.value().get_index());
+        }
+    }
+
+    // Disks added back to the view are found again, also in cells which were pruned for the view
+    for (int i = 0; i < 1000; i++) {
+        if (i % 4 == 0 && !erased.empty()) {
+            view.insert(erased.back());
+            erased.pop_back();
+        }
+
+        auto query = Disk<int>{{rand() % 200, rand() % 200}, 5};
+        auto d1 = grid.intersecting(query, view);
+        auto d2 = naive.intersecting(query, view);
+        ASSERT_EQ(d1.has_value(), d2.has_value());
+
+        if (d1.has_value()) {
+            ASSERT_TRUE(view.alive(d1.value().get_index()));
+            view.erase(d1.value().get_index());
+        }
+    }
+
+    // Border queries continue where the previous one stopped, and find all disks intersecting the border
+    auto border_view = AliveView::all_disks(stamps, stamps.reserve(1));
+    int found = 0;
+    while (auto disk = grid.intersecting(Border<int>{190, false}, border_view)) {
+        ASSERT_TRUE(intersects(disk.value(), Border<int>{190, false}));
+        border_view.erase(disk.value().get_index());
+        found++;
+    }
+    ASSERT_EQ(found, std::count_if(disks.begin(), disks.end(), [](const Disk<int> &disk) {
+        return intersects(disk, Border<int>{190, false});
+    }));
+}
+
+TEST(TestGrid, TestParallelInsertsDropPrefixes) {
+    // Disks added back to a view from several threads at once (as levels are built in parallel) drop dead prefixes
+    auto disks = std::vector<Disk<int>>();
+    for (int i = 0; i < 1000; i++) {
+        disks.push_back(Disk<int>{{rand() % 50, rand() % 50}, 5});
+    }
+    add_index_to_disks(disks);
+
+    auto grid = Grid<int>();
+    grid.rebuild(std::vector<GeometryObject<int>>(disks.begin(), disks.end()));
+
+    auto stamps = AliveStamps(disks.size());
+    auto view = AliveView::all_disks(stamps, stamps.reserve(1));
+    for (int i = 0; i < 1000; i++) {
+        view.erase(i);
+    }
+    ASSERT_EQ(grid.intersecting(Disk<int>{{25, 25}, 100}, view), std::nullopt);
+
+    // Every task adds a chunk of disks, all tasks start before any of them adds a disk (each runs on its own thread)
+    auto pool = ThreadPool(4);
+    std::latch started(4);
+    pool.parallel_for(4, [&view, &started](std::size_t t) {
+        started.arrive_and_wait();
+        for (int i = static_cast<int>(t) * 250; i < static_cast<int>(t + 1) * 250; i++) {
+            view.insert(i);
+        }
+    });
+
+    int found = 0;
+    while (auto disk = grid.intersecting(Disk<int>{{25, 25}, 100}, view)) {
+        view.erase(disk.value().get_index());
+        found++;
+    }
+    ASSERT_EQ(found, 1000);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "data_structure/hierarchical_grid.hpp"
+#include "data_structure/trivial.hpp"
+#include <vector>
+
+void assert_hierarchical_grid_query_is_correct(HierarchicalGrid<int> &grid, Trivial<int> &naive,
+                                               const GeometryObject<int> &object) {
+    auto d1 = grid.intersecting(object);
+    auto d2 = naive.intersecting(object);
+
+    // Check if both solutions agree
+    ASSERT_EQ(d1.has_value(), d2.has_value());
+
+    if (d1.has_value() && d2.has_value()) {
+        // Values might be different, but response is correct as long as d1 is intersecting disk
+        ASSERT_TRUE(intersects(d1.value(), object));
+    }
+}
+
+TEST(TestHierarchicalGrid, TestQuery) {
+    // Disks with radii from different levels
+    const auto objects = std::vector<GeometryObject<int>>{
+            Disk<int>{{0, 0}, 1},
+            Disk<int>{{20, 0}, 10},
+            Disk<int>{{0, 100}, 50},
+            Border<int>{200, false},
+    };
+
+    auto t = HierarchicalGrid<int>();
+    t.rebuild(objects);
+
+    ASSERT_EQ(t.intersecting(Disk<int>{{-1, 0}, 1}), objects[0]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{8, 0}, 2}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{31, 0}, 1}), objects[1]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-50, 100}, 1}), objects[2]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{190, 0}, 20}), objects[3]);
+
+    // Query objects that don't intersect any disk or border
+    ASSERT_EQ(t.intersecting(Disk<int>{{4, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{100, 0}, 50}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, -100}, 20}), std::nullopt);
+
+    // Query with border, expect intersection with disk
+    ASSERT_EQ(t.intersecting(Border<int>{-45, true}), objects[2]);
+}
+
+TEST(TestHierarchicalGrid, TestDeletion) {
+    const auto objects = std::vector<GeometryObject<int>>{
+            Disk<int>{{0, 0}, 1},
+            Disk<int>{{0, 0}, 30},
+            Border<int>{-100, true},
+    };
+
+    auto t = HierarchicalGrid<int>();
+    t.rebuild(objects);
+
+    ASSERT_EQ(t.intersecting(Disk<int>{{25, 0}, 1}), objects[1]);
+    t.delete_object(Disk<int>{{0, 0}, 30});
+    ASSERT_EQ(t.intersecting(Disk<int>{{25, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{1, 0}, 1}), objects[0]);
+
+    // Disks which are not in the structure, one with a radius larger than all levels
+    t.delete_object(Disk<int>{{1, 0}, 1});
+    t.delete_object(Disk<int>{{0, 0}, 1000});
+    ASSERT_EQ(t.intersecting(Disk<int>{{1, 0}, 1}), objects[0]);
+
+    t.delete_object(Disk<int>{{0, 0}, 1});
+    ASSERT_EQ(t.intersecting(Disk<int>{{1, 0}, 1}), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), objects[2]);
+
+    t.delete_object(Border<int>{-100, true});
+    ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), std::nullopt);
+}
+
+TEST(TestHierarchicalGrid, TestLargerCase) {
+    // Generate large random test case with radii from 1 to 50 and compare with naive solution
+    auto random = []() { return rand() % 2233; };
+
+    auto objects = std::vector<GeometryObject<int>>();
+    for (int i = 0; i < 1000; ++i) {
+        objects.push_back(Disk<int>{{random(), random()}, 1 + rand() % 50});
+    }
+
+    auto grid = HierarchicalGrid<int>();
+    auto naive = Trivial<int>();
+    grid.rebuild(objects);
+    naive.rebuild(objects);
+
+    // 1000 random queries
+    for (int i = 0; i < 1000; ++i) {
+        assert_hierarchical_grid_query_is_correct(grid, naive, Disk<int>{{random(), random()}, 1 + rand() % 50});
+    }
+
+    // Delete disks intersecting right border one by one
+    while (true) {
+        auto found = grid.intersecting(Border<int>{2000, false});
+        assert_hierarchical_grid_query_is_correct(grid, naive, Border<int>{2000, false});
+        if (!found.has_value()) {
+            break;
+        }
+        grid.delete_object(found.value());
+        naive.delete_object(found.value());
+    }
+
+    // 500 random deletions
+    for (int i = 0; i < 500; ++i) {
+        auto disk = objects[rand() % objects.size()];
+        grid.delete_object(disk);
+        naive.delete_object(disk);
+    }
+
+    // 1000 random queries
+    for (int i = 0; i < 1000; ++i) {
+        assert_hierarchical_grid_query_is_correct(grid, naive, Disk<int>{{random(), random()}, 1 + rand() % 50});
+    }
+}
+
+TEST(TestHierarchicalGrid, TestQueryOnViews) {
+    // Random disks, mixed radii
+    auto disks = std::vector<Disk<int>>();
+    for (int i = 0; i < 1000; i++) {
+        disks.push_back(Disk<int>{{rand() % 500, rand() % 500}, 1 + rand() % 40});
+    }
+    add_index_to_disks(disks);
+
+    const auto objects = std::vector<GeometryObject<int>>(disks.begin(), disks.end());
+    auto grid = HierarchicalGrid<int>();
+    grid.rebuild(objects);
+    auto naive = Trivial<int>();
+    naive.rebuild(objects);
+
+    auto stamps = AliveStamps(disks.size());
+    auto view = AliveView::all_disks(stamps, stamps.reserve(1));
+
+    // Delete disks from the view, both structures should see the same alive disks
+    for (int i = 0; i < 1000; i++) {
+        auto query = Disk<int>{{rand() % 500, rand() % 500}, 1 + rand() % 40};
+        auto d1 = grid.intersecting(query, view);
+        auto d2 = naive.intersecting(query, view);
+        ASSERT_EQ(d1.has_value(), d2.has_value());
+
+        if (d1.has_value()) {
+            ASSERT_TRUE(intersects(d1.value(), query));
+            ASSERT_TRUE(view.alive(d1.value().get_index()));
+            view.erase(d1.value().get_index());
+        }
+    }
+
+    // Border queries go through all levels and find all disks intersecting the border
+    auto border_view = AliveView::all_disks(stamps, stamps.reserve(1));
+    int found = 0;
+    while (auto disk = grid.intersecting(Border<int>{30, true}, border_view)) {
+        ASSERT_TRUE(intersects(disk.value(), Border<int>{30, true}));
+        border_view.erase(disk.value().get_index());
+        found++;
+    }
+    ASSERT_EQ(found, std::count_if(disks.begin(), disks.end(), [](const Disk<int> &disk) {
+        return intersects(disk, Border<int>{30, true});
+    }));
+}
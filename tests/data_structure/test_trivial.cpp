@@ -73,4 +73,43 @@ TEST(TestTrivialDataStructure, TestDelection) {
 
     t.delete_object(Border<int>{-100, true});
     ASSERT_EQ(t.intersecting(Disk<int>{{-100, 0}, 1}), std::nullopt);
-}
\ No newline at end of file
+}
+
+TEST(TestTrivialDataStructure, TestQueryOnViews) {
+    auto disks = std::vector<Disk<int>>{
+            Disk<int>{{0, 0}, 1},
+            Disk<int>{{1, 0}, 1},
+            Disk<int>{{5, 0}, 1},
+    };
+    add_index_to_disks(disks);
+
+    auto t = Trivial<int>();
+    t.rebuild(std::vector<GeometryObject<int>>(disks.begin(), disks.end()));
+
+    auto stamps = AliveStamps(disks.size());
+    auto all = AliveView::all_disks(stamps, stamps.reserve(1));
+    auto members = AliveView::members(stamps, stamps.reserve(1));
+
+    // Empty view does not see any disk, full view sees all of them
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 1}, 1}, members), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 1}, 1}, all), disks[0]);
+
+    // Deleting from a view does not change the structure
+    all.erase(0);
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 1}, 1}, all), disks[1]);
+    all.erase(1);
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 1}, 1}, all), std::nullopt);
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 1}, 1}), static_cast<GeometryObject<int>>(disks[0]));
+
+    members.insert(2);
+    ASSERT_EQ(t.intersecting(Disk<int>{{5, 1}, 1}, members), disks[2]);
+    ASSERT_EQ(t.intersecting(Disk<int>{{0, 1}, 1}, members), std::nullopt);
+
+    // Border queries continue where the previous one stopped
+    auto view = AliveView::all_disks(stamps, stamps.reserve(1));
+    ASSERT_EQ(t.intersecting(Border<int>{0, true}, view), disks[0]);
+    view.erase(0);
+    ASSERT_EQ(t.intersecting(Border<int>{0, true}, view), disks[1]);
+    view.erase(1);
+    ASSERT_EQ(t.intersecting(Border<int>{0, true}, view), std::nullopt);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <set>
+#include <unordered_set>
+#include "utils/flat_hash_set.hpp"
+#include "utils/transformed_graph.hpp"
+
+TEST(TestFlatHashSet, TestInsertEraseContains) {
+    auto set = FlatHashSet();
+    ASSERT_FALSE(set.contains(1));
+    ASSERT_FALSE(set.erase(1));
+
+    ASSERT_TRUE(set.insert(1));
+    ASSERT_FALSE(set.insert(1));
+    ASSERT_TRUE(set.insert(0));
+    ASSERT_EQ(set.size(), 2);
+    ASSERT_TRUE(set.contains(0));
+    ASSERT_TRUE(set.contains(1));
+
+    ASSERT_TRUE(set.erase(1));
+    ASSERT_FALSE(set.contains(1));
+    ASSERT_TRUE(set.contains(0));
+    ASSERT_EQ(set.size(), 1);
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.contains(0));
+}
+
+TEST(TestFlatHashSet, TestMatchesStdSet) {
+    // Random inserts and erases (with growing), compare with std::set
+    auto set = FlatHashSet();
+    std::set<uint64_t> expected;
+
+    for (int i = 0; i < 100000; i++) {
+        uint64_t key = rand() % 5000;
+        if (rand() % 3 == 0) {
+            ASSERT_EQ(set.erase(key), expected.erase(key) == 1);
+        } else {
+            ASSERT_EQ(set.insert(key), expected.insert(key).second);
+        }
+        ASSERT_EQ(set.size(), expected.size());
+    }
+
+    for (uint64_t key = 0; key < 5000; key++) {
+        ASSERT_EQ(set.contains(key), expected.contains(key));
+    }
+
+    std::set<uint64_t> keys;
+    set.for_each([&keys](uint64_t key) { keys.insert(key); });
+    ASSERT_EQ(keys, expected);
+}
+
+TEST(TestFlatHashSet, TestPackedKeys) {
+    // Packing is reversible
+    for (int i = -1; i < 100; i++) {
+        for (bool inbound: {false, true}) {
+            auto v = TransformedVertex{i, inbound};
+            ASSERT_EQ(unpack_vertex(pack_vertex(v)), v);
+            ASSERT_EQ(unpack_edge(pack_edge({v, sink})), Edge(v, sink));
+        }
+    }
+    ASSERT_EQ(pack_vertex(source), 0);
+    ASSERT_EQ(pack_vertex(sink), 1);
+
+    // Vertices (2k, out) and (2k + 1, in), and edges v -> u and u -> v have different hashes
+    std::unordered_set<size_t> vertex_hashes, edge_hashes;
+    for (int k = 0; k < 100; k++) {
+        auto a = TransformedVertex{2 * k, false};
+        auto b = TransformedVertex{2 * k + 1, true};
+        vertex_hashes.insert(TransformedVertexHash()(a));
+        vertex_hashes.insert(TransformedVertexHash()(b));
+        edge_hashes.insert(EdgeHash()(Edge(a, b)));
+        edge_hashes.insert(EdgeHash()(Edge(b, a)));
+    }
+    ASSERT_EQ(vertex_hashes.size(), 200);
+    ASSERT_EQ(edge_hashes.size(), 200);
+}
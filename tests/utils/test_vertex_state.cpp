@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "utils/vertex_state.hpp"
+
+TEST(TestVertexState, TestVertexIds) {
+    // Source and sink are first two vertices
+    ASSERT_EQ(vertex_id(source), 0);
+    ASSERT_EQ(vertex_id(sink), 1);
+    ASSERT_EQ((vertex_id({0, false})), 2);
+    ASSERT_EQ((vertex_id({0, true})), 3);
+    ASSERT_EQ((vertex_id({4, true})), 11);
+
+    // All ids are different and can be converted back to vertices
+    for (int id = 0; id < number_of_vertices(10); id++) {
+        ASSERT_EQ(vertex_id(vertex_from_id(id)), id);
+    }
+    ASSERT_EQ(vertex_from_id(0), source);
+    ASSERT_EQ(vertex_from_id(1), sink);
+}
+
+TEST(TestVertexState, TestLevels) {
+    auto levels = VertexLevels(3);
+    ASSERT_EQ(levels.size(), 0);
+
+    levels.set(source, 0);
+    levels.set({1, true}, 1);
+    levels.set({2, true}, 1);
+    levels.set({1, false}, 2);
+
+    ASSERT_EQ(levels.size(), 4);
+    ASSERT_TRUE(levels.contains(source));
+    ASSERT_FALSE(levels.contains(sink));
+    ASSERT_FALSE((levels.contains({0, true})));
+    ASSERT_EQ((levels[{2, true}]), 1);
+    ASSERT_EQ((levels[{0, true}]), -1);
+
+    // Vertices are grouped by level in order of insertion
+    ASSERT_EQ(levels.vertices_with_level(1), (std::vector<TransformedVertex>{{1, true}, {2, true}}));
+    ASSERT_EQ(levels.vertices_with_level(2), (std::vector<TransformedVertex>{{1, false}}));
+    ASSERT_TRUE(levels.vertices_with_level(3).empty());
+
+    // Clearing a level removes all its vertices
+    levels.clear_level(1);
+    ASSERT_EQ(levels.size(), 2);
+    ASSERT_FALSE((levels.contains({1, true})));
+    ASSERT_TRUE(levels.vertices_with_level(1).empty());
+    levels.set(sink, 1);
+    ASSERT_EQ(levels.vertices_with_level(1), (std::vector<TransformedVertex>{sink}));
+}
+
+TEST(TestVertexState, TestLinksAndSet) {
+    auto links = VertexLinks(3);
+    links.set(source, {0, true});
+    links.set({0, false}, sink);
+
+    ASSERT_TRUE(links.contains(source));
+    ASSERT_FALSE(links.contains(sink));
+    ASSERT_EQ(links[source], (TransformedVertex{0, true}));
+    ASSERT_TRUE((links.points_to({0, false}, sink)));
+    ASSERT_FALSE((links.points_to({1, false}, sink)));
+
+    links.erase({0, false});
+    ASSERT_FALSE((links.contains({0, false})));
+
+    // Set spans multiple words
+    auto set = VertexSet(100);
+    for (int i = 0; i < 100; i += 3) {
+        set.insert({i, true});
+    }
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ((set.contains({i, true})), i % 3 == 0);
+        ASSERT_FALSE((set.contains({i, false})));
+    }
+}
@@ -62,6 +62,21 @@ TEST(TestEvenTarjan, TestDfsOnBfsTree) {
                                                                       }));
 }
 
+TEST(TestEvenTarjan, TestDfsOnLongPath) {
+    // Path 0 -> 1 -> ... -> n - 1, recursive DFS would need a stack frame per vertex.
+    const int n = 1000000;
+    Graph t(n);
+    for (int i = 0; i + 1 < n; i++) {
+        t[i].push_back(i + 1);
+    }
+
+    auto paths = dfs_on_bfs_tree(t, 0, n - 1);
+    ASSERT_EQ(paths.size(), 1);
+    ASSERT_EQ(paths[0].size(), n);
+    ASSERT_EQ(paths[0].front(), 0);
+    ASSERT_EQ(paths[0].back(), n - 1);
+}
+
 TEST(TestEvenTarjan, TestCreateBfsTree) {
     ASSERT_EQ(create_bfs_tree({-1, 0, 0, 1, 1, 2, 2}), Graph({
                                                                      {1, 2},